@@ -32,6 +32,7 @@
 #include "cute_array.h"
 #include "cute_audio.h"
 #include "cute_base64.h"
+#include "cute_binary.h"
 #include "cute_clipboard.h"
 #include "cute_color.h"
 #include "cute_multithreading.h"
@@ -54,6 +55,7 @@
 #include "cute_rnd.h"
 #include "cute_sprite.h"
 #include "cute_string.h"
+#include "cute_tilemap.h"
 #include "cute_time.h"
 #include "cute_version.h"
 #include "cute_routine.h"
@@ -202,6 +202,8 @@ CF_API CF_DisplayOrientation CF_CALL cf_display_orientation(CF_DisplayID display
 	CF_ENUM(APP_OPTIONS_GFX_VULKAN_BIT,                         1 << 10) \
 	/* @entry Starts the application with a debug mode graphics context. */ \
 	CF_ENUM(APP_OPTIONS_GFX_DEBUG_BIT,                          1 << 11) \
+	/* @entry Starts the application with a null graphics backend, for headless benchmarks and tests. Textures, meshes, shaders and draw calls are all accepted and counted (see `cf_draw_get_stats`), but nothing reaches a GPU and nothing is displayed. */ \
+	CF_ENUM(APP_OPTIONS_GFX_NULL_BIT,                           1 << 12) \
 	/* @end */
 
 typedef int CF_AppOptionFlags;
@@ -337,7 +339,7 @@ CF_API void CF_CALL cf_app_update(CF_OnUpdateFn* on_update);
  * @function cf_app_draw_onto_screen
  * @category app
  * @brief    Draws the app onto the screen.
- * @return   Returns the number of draw calls for this frame.
+ * @return   Returns the number of draw calls for this frame. See `cf_draw_get_stats` for the number of render passes and more.
  * @example > Creating a basic 640x480 window for your game.
  *     #include <cute.h>
  *     using namespace cute;
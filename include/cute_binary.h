@@ -0,0 +1,249 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#ifndef CF_BINARY_H
+#define CF_BINARY_H
+
+#include "cute_defines.h"
+#include "cute_result.h"
+
+//--------------------------------------------------------------------------------------------------
+// C API
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// Layout of a binary container, all integers are little-endian.
+//
+//     Header (32 bytes)
+//         uint32 magic                 'CFBN'
+//         uint16 version               CF_BINARY_VERSION
+//         uint16 flags                 Reserved, must be zero.
+//         uint32 section_count
+//         uint32 section_table_offset  From the beginning of the file.
+//         uint32 string_table_offset   From the beginning of the file.
+//         uint32 string_table_size     In bytes, including every nul-terminator.
+//         uint64 total_size            Size of the entire file in bytes.
+//     Section table (24 bytes per section)
+//         uint32 name                  Offset into the string table.
+//         uint32 reserved
+//         uint64 offset                From the beginning of the file, aligned to CF_BINARY_ALIGNMENT.
+//         uint64 size                  In bytes.
+//     String table
+//         Nul-terminated UTF-8 strings packed back to back. Offset 0 is always the empty string.
+//     Section data
+//         Raw bytes for each section, each aligned to CF_BINARY_ALIGNMENT.
+//
+// Every offset is relative to the beginning of the file, so a file can be memory mapped (or loaded
+// with a single read) and used in place without any parsing step.
+
+/**
+ * @function CF_BINARY_VERSION
+ * @category serialization
+ * @brief    The version number written into the header of binary containers.
+ * @remarks  `cf_binary_reader_init` will fail on any container written with a different version.
+ * @related  CF_BINARY_VERSION CF_BINARY_ALIGNMENT CF_BinaryReader cf_binary_reader_init cf_make_binary_writer
+ */
+#define CF_BINARY_VERSION 1
+
+/**
+ * @function CF_BINARY_ALIGNMENT
+ * @category serialization
+ * @brief    The alignment, in bytes, of each section within a binary container.
+ * @remarks  Sections are aligned so structs of floats, ints, or SIMD types can be read in place, assuming the container
+ *           itself was loaded at an address with at least this alignment (`cf_alloc` and memory mapped files both are).
+ * @related  CF_BINARY_VERSION CF_BINARY_ALIGNMENT CF_BinaryReader cf_binary_reader_init cf_make_binary_writer
+ */
+#define CF_BINARY_ALIGNMENT 16
+
+/**
+ * @struct   CF_BinaryWriter
+ * @category serialization
+ * @brief    An opaque handle for building a binary container.
+ * @remarks  Add strings and sections, then call `cf_binary_writer_finish` to get the final contiguous buffer.
+ * @related  cf_make_binary_writer cf_destroy_binary_writer cf_binary_writer_add_string cf_binary_writer_add_section cf_binary_writer_finish
+ */
+typedef struct CF_BinaryWriter { uint64_t id; } CF_BinaryWriter;
+/* @end */
+
+/**
+ * @struct   CF_BinaryReader
+ * @category serialization
+ * @brief    A view over an existing binary container in memory.
+ * @remarks  The reader never copies or allocates, it simply points into the memory passed to `cf_binary_reader_init`.
+ *           That memory must outlive the reader.
+ * @related  CF_BinaryReader cf_binary_reader_init cf_binary_section_count cf_binary_section cf_binary_section_at cf_binary_string
+ */
+typedef struct CF_BinaryReader
+{
+	/* @member Pointer to the beginning of the container. */
+	const uint8_t* data;
+
+	/* @member Size of the container in bytes. */
+	size_t size;
+
+	/* @member Number of sections in the container. */
+	int section_count;
+
+	/* @member Pointer to the section table. */
+	const uint8_t* sections;
+
+	/* @member Pointer to the string table. */
+	const char* strings;
+
+	/* @member Size of the string table in bytes. */
+	uint32_t strings_size;
+} CF_BinaryReader;
+// @end
+
+/**
+ * @function cf_make_binary_writer
+ * @category serialization
+ * @brief    Returns a new binary container writer.
+ * @remarks  Free it up with `cf_destroy_binary_writer` when done.
+ * @related  CF_BinaryWriter cf_make_binary_writer cf_destroy_binary_writer cf_binary_writer_add_string cf_binary_writer_add_section cf_binary_writer_finish
+ */
+CF_API CF_BinaryWriter CF_CALL cf_make_binary_writer();
+
+/**
+ * @function cf_destroy_binary_writer
+ * @category serialization
+ * @brief    Frees up all resources used by a binary container writer.
+ * @param    w            The writer.
+ * @related  CF_BinaryWriter cf_make_binary_writer cf_destroy_binary_writer cf_binary_writer_add_string cf_binary_writer_add_section cf_binary_writer_finish
+ */
+CF_API void CF_CALL cf_destroy_binary_writer(CF_BinaryWriter w);
+
+/**
+ * @function cf_binary_writer_add_string
+ * @category serialization
+ * @brief    Adds a string to the string table and returns its offset.
+ * @param    w            The writer.
+ * @param    string       The string to add.
+ * @return   Returns the offset of the string within the string table.
+ * @remarks  Identical strings are only stored once. Store the returned offset inside your own section data and fetch the
+ *           string back later with `cf_binary_string`, this keeps section data fixed-size and free of pointers.
+ * @related  CF_BinaryWriter cf_binary_writer_add_string cf_binary_writer_add_section cf_binary_string
+ */
+CF_API uint32_t CF_CALL cf_binary_writer_add_string(CF_BinaryWriter w, const char* string);
+
+/**
+ * @function cf_binary_writer_add_section
+ * @category serialization
+ * @brief    Adds a named section of raw bytes to the container.
+ * @param    w            The writer.
+ * @param    name         The name of the section, used for lookups with `cf_binary_section`.
+ * @param    data         The bytes of the section. These are copied.
+ * @param    size         The number of bytes in `data`.
+ * @remarks  The data is copied as-is, so store it in little-endian if the container is meant to travel across platforms.
+ * @related  CF_BinaryWriter cf_binary_writer_add_string cf_binary_writer_add_section cf_binary_writer_finish cf_binary_section
+ */
+CF_API void CF_CALL cf_binary_writer_add_section(CF_BinaryWriter w, const char* name, const void* data, size_t size);
+
+/**
+ * @function cf_binary_writer_finish
+ * @category serialization
+ * @brief    Lays out the final container into a single contiguous buffer.
+ * @param    w            The writer.
+ * @param    size         Set to the size of the returned buffer in bytes.
+ * @return   Returns the container, free it with `cf_free` when done.
+ * @remarks  The writer is left untouched, so more sections may be added and `cf_binary_writer_finish` called again.
+ *           Save the buffer with `cf_fs_write_entire_buffer_to_file`.
+ * @related  CF_BinaryWriter cf_binary_writer_add_section cf_binary_writer_finish cf_binary_reader_init
+ */
+CF_API void* CF_CALL cf_binary_writer_finish(CF_BinaryWriter w, size_t* size);
+
+/**
+ * @function cf_binary_reader_init
+ * @category serialization
+ * @brief    Validates a binary container and initializes a reader to look at it in place.
+ * @param    r            The reader to initialize.
+ * @param    data         The container, e.g. from `cf_fs_read_entire_file_to_memory` or a memory mapped file.
+ * @param    size         The size of `data` in bytes.
+ * @return   Returns a `CF_Result` containing information about any errors.
+ * @remarks  Only the header, section table and string table are validated. No copies are made and nothing is allocated.
+ * @related  CF_BinaryReader cf_binary_reader_init cf_binary_section_count cf_binary_section cf_binary_section_at cf_binary_string
+ */
+CF_API CF_Result CF_CALL cf_binary_reader_init(CF_BinaryReader* r, const void* data, size_t size);
+
+/**
+ * @function cf_binary_section_count
+ * @category serialization
+ * @brief    Returns the number of sections in the container.
+ * @param    r            The reader.
+ * @related  CF_BinaryReader cf_binary_section_count cf_binary_section cf_binary_section_at
+ */
+CF_API int CF_CALL cf_binary_section_count(const CF_BinaryReader* r);
+
+/**
+ * @function cf_binary_section
+ * @category serialization
+ * @brief    Returns a pointer to the data of a section by name, or `NULL` if not found.
+ * @param    r            The reader.
+ * @param    name         The name of the section.
+ * @param    size         Set to the size of the section in bytes. Can be `NULL`.
+ * @remarks  The returned pointer points directly into the container, it's aligned to `CF_BINARY_ALIGNMENT`.
+ * @related  CF_BinaryReader cf_binary_section_count cf_binary_section cf_binary_section_at
+ */
+CF_API const void* CF_CALL cf_binary_section(const CF_BinaryReader* r, const char* name, size_t* size);
+
+/**
+ * @function cf_binary_section_at
+ * @category serialization
+ * @brief    Returns a pointer to the data of a section by index.
+ * @param    r            The reader.
+ * @param    index        The index of the section, from 0 to `cf_binary_section_count` - 1.
+ * @param    name         Set to the name of the section. Can be `NULL`.
+ * @param    size         Set to the size of the section in bytes. Can be `NULL`.
+ * @remarks  The returned pointer points directly into the container, it's aligned to `CF_BINARY_ALIGNMENT`.
+ * @related  CF_BinaryReader cf_binary_section_count cf_binary_section cf_binary_section_at
+ */
+CF_API const void* CF_CALL cf_binary_section_at(const CF_BinaryReader* r, int index, const char** name, size_t* size);
+
+/**
+ * @function cf_binary_string
+ * @category serialization
+ * @brief    Returns a string from the string table by offset.
+ * @param    r            The reader.
+ * @param    offset       An offset previously returned by `cf_binary_writer_add_string`.
+ * @return   Returns the string, or the empty string if `offset` is out of bounds.
+ * @related  CF_BinaryReader cf_binary_writer_add_string cf_binary_string
+ */
+CF_API const char* CF_CALL cf_binary_string(const CF_BinaryReader* r, uint32_t offset);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+//--------------------------------------------------------------------------------------------------
+// C++ API
+
+#ifdef CF_CPP
+
+namespace Cute
+{
+
+using BinaryWriter = CF_BinaryWriter;
+using BinaryReader = CF_BinaryReader;
+
+CF_INLINE BinaryWriter make_binary_writer() { return cf_make_binary_writer(); }
+CF_INLINE void destroy_binary_writer(BinaryWriter w) { cf_destroy_binary_writer(w); }
+CF_INLINE uint32_t binary_writer_add_string(BinaryWriter w, const char* string) { return cf_binary_writer_add_string(w, string); }
+CF_INLINE void binary_writer_add_section(BinaryWriter w, const char* name, const void* data, size_t size) { cf_binary_writer_add_section(w, name, data, size); }
+CF_INLINE void* binary_writer_finish(BinaryWriter w, size_t* size) { return cf_binary_writer_finish(w, size); }
+CF_INLINE Result binary_reader_init(BinaryReader* r, const void* data, size_t size) { return cf_binary_reader_init(r, data, size); }
+CF_INLINE int binary_section_count(const BinaryReader* r) { return cf_binary_section_count(r); }
+CF_INLINE const void* binary_section(const BinaryReader* r, const char* name, size_t* size = NULL) { return cf_binary_section(r, name, size); }
+CF_INLINE const void* binary_section_at(const BinaryReader* r, int index, const char** name = NULL, size_t* size = NULL) { return cf_binary_section_at(r, index, name, size); }
+CF_INLINE const char* binary_string(const BinaryReader* r, uint32_t offset) { return cf_binary_string(r, offset); }
+
+}
+
+#endif // CF_CPP
+
+#endif // CF_BINARY_H
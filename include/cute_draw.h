@@ -30,6 +30,18 @@ extern "C" {
  */
 CF_API void CF_CALL cf_draw_sprite(const CF_Sprite* sprite);
 
+/**
+ * @function cf_draw_sprites
+ * @category draw
+ * @brief    Draws an array of sprites.
+ * @param    sprites    The sprites.
+ * @param    count      The number of sprites in `sprites`.
+ * @remarks  Draws the same as calling `cf_draw_sprite` on each sprite, but is considerably cheaper on the CPU for large numbers of
+ *           sprites, e.g. particles or a crowd of units.
+ * @related  cf_draw_sprite cf_draw_sprites cf_draw_circles_fill
+ */
+CF_API void CF_CALL cf_draw_sprites(const CF_Sprite* sprites, int count);
+
 /**
  * @function cf_draw_quad
  * @category draw
@@ -193,6 +205,19 @@ CF_API void CF_CALL cf_draw_circle_fill(CF_Circle circle);
  */
 CF_API void CF_CALL cf_draw_circle_fill2(CF_V2 p, float r);
 
+/**
+ * @function cf_draw_circles_fill
+ * @category draw
+ * @brief    Draws an array of filled circles.
+ * @param    centers    Center of each circle.
+ * @param    radii      Radius of each circle.
+ * @param    count      The number of circles.
+ * @remarks  Draws the same as calling `cf_draw_circle_fill2` on each circle, but is considerably cheaper on the CPU for large numbers
+ *           of circles.
+ * @related  cf_draw_circle cf_draw_circle2 cf_draw_circle_fill cf_draw_circle_fill2 cf_draw_circles_fill cf_draw_sprites
+ */
+CF_API void CF_CALL cf_draw_circles_fill(const CF_V2* centers, const float* radii, int count);
+
 /**
  * @function cf_draw_capsule
  * @category draw
@@ -303,13 +328,34 @@ CF_API void CF_CALL cf_draw_polygon_fill(CF_V2* points, int count, float chubbin
  * @param    points       An array of points to define the polygon surface.
  * @param    count        The number of points in the polygon.
  * @remarks  Unlike `cf_draw_polygon_fill`, this function can render a higher number of vertices than 8. However, the polygon
- *           must be a _simple polygon_, meaning no self-intersections are allowed, no duplicate or overlapping vertices are
- *           allowed, and other features like chubbiness or antialias can not be applied. This function simply converts your
- *           polygon and renders a series of triangles under the hood. Please be sure to submit your vertices in CCW order.
- * @related  cf_draw_line cf_draw_polyline cf_draw_bezier_line cf_draw_bezier_line2 cf_draw_arrow cf_draw_polygon_fill cf_draw_polygon_fill_simple
+ *           must be a _simple polygon_, meaning no self-intersections are allowed, and other features like chubbiness or antialias
+ *           can not be applied. This function triangulates your polygon in O(n log n) and renders a series of triangles under the
+ *           hood. Vertices may be in CW or CCW order, and repeated or collinear vertices are skipped. To skip triangulation for
+ *           polygons drawn unchanged each frame see `cf_draw_set_tessellation_cache`.
+ * @related  cf_draw_line cf_draw_polyline cf_draw_bezier_line cf_draw_bezier_line2 cf_draw_arrow cf_draw_polygon_fill cf_draw_polygon_fill_simple cf_draw_set_tessellation_cache
  */
 CF_API void CF_CALL cf_draw_polygon_fill_simple(CF_V2* points, int count);
 
+/**
+ * @function cf_draw_set_tessellation_cache
+ * @category draw
+ * @brief    Turns on or off caching of triangulated polygons for `cf_draw_polygon_fill_simple`.
+ * @param    true_turn_on_cache  True to turn the cache on, false to turn it off. Off by default.
+ * @remarks  Polygons are looked up by a hash of their points, so drawing the exact same points again skips triangulation entirely.
+ *           Polygons that weren't drawn during the previous frame are evicted by `cf_app_draw_onto_screen`. This mostly helps with
+ *           large polygons (hundreds of vertices or more) that rarely change, e.g. in an editor. Turning the cache off frees it.
+ * @related  cf_draw_polygon_fill_simple cf_draw_set_tessellation_cache cf_draw_get_tessellation_cache
+ */
+CF_API void CF_CALL cf_draw_set_tessellation_cache(bool true_turn_on_cache);
+
+/**
+ * @function cf_draw_get_tessellation_cache
+ * @category draw
+ * @brief    Returns true if triangulated polygons are being cached, see `cf_draw_set_tessellation_cache`.
+ * @related  cf_draw_polygon_fill_simple cf_draw_set_tessellation_cache cf_draw_get_tessellation_cache
+ */
+CF_API bool CF_CALL cf_draw_get_tessellation_cache();
+
 /**
  * @function cf_draw_bezier_line
  * @category draw
@@ -472,6 +518,43 @@ CF_API float CF_CALL cf_draw_pop_antialias_scale();
  */
 CF_API float CF_CALL cf_draw_peek_antialias_scale();
 
+/**
+ * @function cf_draw_push_culling
+ * @category draw
+ * @brief    Pushes whether or not to cull offscreen items.
+ * @param    cull       True to skip drawing items that are entirely offscreen, false otherwise.
+ * @remarks  Culling skips any sprite, shape or glyph lying entirely outside of the canvas, before it's sorted or turned into vertices.
+ *           It's off by default. Turn it on around large worlds with many offscreen items, and check `CF_DrawStats::culled_count` with
+ *           `cf_draw_get_stats`. Items are tested against the canvas using the current camera, so a vertex callback moving vertices
+ *           back onscreen (see `cf_set_vertex_callback`) can make culled items pop in.
+ * @related  cf_draw_push_culling cf_draw_pop_culling cf_draw_peek_culling cf_draw_get_stats
+ */
+CF_API void CF_CALL cf_draw_push_culling(bool cull);
+
+/**
+ * @function cf_draw_pop_culling
+ * @category draw
+ * @brief    Pops and returns the last culling state.
+ * @remarks  Culling skips any sprite, shape or glyph lying entirely outside of the canvas, before it's sorted or turned into vertices.
+ *           It's off by default. Turn it on around large worlds with many offscreen items, and check `CF_DrawStats::culled_count` with
+ *           `cf_draw_get_stats`. Items are tested against the canvas using the current camera, so a vertex callback moving vertices
+ *           back onscreen (see `cf_set_vertex_callback`) can make culled items pop in.
+ * @related  cf_draw_push_culling cf_draw_pop_culling cf_draw_peek_culling cf_draw_get_stats
+ */
+CF_API bool CF_CALL cf_draw_pop_culling();
+
+/**
+ * @function cf_draw_peek_culling
+ * @category draw
+ * @brief    Returns the last culling state.
+ * @remarks  Culling skips any sprite, shape or glyph lying entirely outside of the canvas, before it's sorted or turned into vertices.
+ *           It's off by default. Turn it on around large worlds with many offscreen items, and check `CF_DrawStats::culled_count` with
+ *           `cf_draw_get_stats`. Items are tested against the canvas using the current camera, so a vertex callback moving vertices
+ *           back onscreen (see `cf_set_vertex_callback`) can make culled items pop in.
+ * @related  cf_draw_push_culling cf_draw_pop_culling cf_draw_peek_culling cf_draw_get_stats
+ */
+CF_API bool CF_CALL cf_draw_peek_culling();
+
 /**
  * @function cf_draw_push_vertex_attributes
  * @category draw
@@ -563,6 +646,9 @@ typedef struct CF_Vertex
 
 	/* @member Four general purpose floats passed into custom user shaders. */
 	CF_Color attributes;
+
+	/* @member For internal use -- Clip-space rectangle (min x, min y, max x, max y) as signed normalized shorts, anything outside of it is clipped. See `cf_draw_set_vertex_scissor`. */
+	int16_t clip[4];
 } CF_Vertex;
 // @end
 
@@ -1463,10 +1549,12 @@ CF_API CF_Aabb CF_CALL cf_screen_bounds_to_world();
  * @param    canvas     The canvas to draw.
  * @param    position   The position to draw at.
  * @param    scale      The scale of the canvas, w/h.
- * @remarks  This function creates an entire dedicated draw call internally. This means it's a fairly expensive
- *           function, so be sure to use it sparingly. If you apply a custom shader you may read pixels from the
- *           canvas as it's draw by `texture(u_image, v_uv)`. Feel free to copy `v_uv` into your own `vec2 uv = v_uv;`
- *           and sample from the canvas as-needed.
+ * @remarks  With the default shader the canvas is drawn as a regular textured quad through the same pipeline and vertex buffer
+ *           as sprites and shapes, in its own batch so it keeps its place in the draw order. Consecutive draws of the same canvas
+ *           with the same state share that batch, and a single draw call. With a custom shader the canvas gets a dedicated blit
+ *           instead, again shared by consecutive draws of the same canvas with the same state. In the custom shader you may
+ *           read pixels from the canvas as it's drawn by `texture(u_image, v_uv)`. Feel free to copy `v_uv` into your
+ *           own `vec2 uv = v_uv;` and sample from the canvas as-needed.
  * @related  cf_app_draw_onto_screen cf_render_to cf_draw_canvas
  */
 CF_API void CF_CALL cf_draw_canvas(CF_Canvas canvas, CF_V2 position, CF_V2 scale);
@@ -1483,6 +1571,259 @@ CF_API void CF_CALL cf_draw_canvas(CF_Canvas canvas, CF_V2 position, CF_V2 scale
  */
 CF_API void CF_CALL cf_render_to(CF_Canvas canvas, bool clear);
 
+/**
+ * @struct   CF_DrawStats
+ * @category draw
+ * @brief    Statistics about how the draw API rendered the previous frame.
+ * @remarks  With instancing on (see `cf_draw_set_instancing`) each sprite or shape is sent to the GPU as a single instance record.
+ *           Otherwise batches made up entirely of sprites and text use a compact vertex format, while batches mixing in shapes
+ *           use the full `CF_Vertex`. Setting a vertex callback with `cf_set_vertex_callback` forces the full format for everything.
+ *           Compare `bytes_per_sprite` and `vertex_bytes` to see the difference.
+ * @related  CF_DrawStats cf_draw_get_stats cf_draw_set_instancing cf_app_draw_onto_screen
+ */
+typedef struct CF_DrawStats
+{
+	/* @member Number of draw calls issued, the same value returned by `cf_app_draw_onto_screen`. */
+	int draw_call_count;
+
+	/* @member Number of render passes begun. Consecutive draws onto the same canvas share a single render pass. */
+	int render_pass_count;
+
+	/* @member Number of batches flushed to the GPU. */
+	int batch_count;
+
+	/* @member Number of vertex buffer uploads. Batches are uploaded together once per `cf_render_to`, so this stays small no matter how large `batch_count` gets. */
+	int upload_count;
+
+	/* @member Number of batches that used the compact sprite-only vertex format. */
+	int sprite_batch_count;
+
+	/* @member Number of batches drawn with instancing, see `cf_draw_set_instancing`. */
+	int instanced_batch_count;
+
+	/* @member Number of sprites and text glyphs rendered. */
+	int sprite_count;
+
+	/* @member Number of sprites, shapes and text glyphs skipped for being offscreen, see `cf_draw_push_culling`. */
+	int culled_count;
+
+	/* @member Number of batches avoided by reordering commands within a layer, see `cf_draw_set_batch_reordering`. */
+	int batches_saved;
+
+	/* @member Total bytes of vertex data uploaded. */
+	uint64_t vertex_bytes;
+
+	/* @member Bytes of vertex data uploaded for sprites and text glyphs alone. */
+	uint64_t sprite_vertex_bytes;
+
+	/* @member Average number of vertex bytes spent on each sprite, `sprite_vertex_bytes / sprite_count`. */
+	float bytes_per_sprite;
+} CF_DrawStats;
+// @end
+
+/**
+ * @function cf_draw_set_instancing
+ * @category draw
+ * @brief    Turns instanced rendering of sprites and shapes on or off. On by default.
+ * @param    true_turn_on_instancing  True to draw with instancing, false to emit six vertices per sprite or shape.
+ * @remarks  With instancing each sprite, circle, capsule, box or polygon is uploaded as one instance record and expanded over a shared
+ *           quad on the GPU, instead of six fully duplicated `CF_Vertex`s. Batches containing lines or plain triangles can't be
+ *           instanced and always use vertices, as does everything while a vertex callback is set (see `cf_set_vertex_callback`).
+ *           Rendering results are identical either way, so this is mostly useful to compare performance with `cf_draw_get_stats`.
+ * @related  cf_draw_set_instancing cf_draw_get_instancing cf_draw_get_stats
+ */
+CF_API void CF_CALL cf_draw_set_instancing(bool true_turn_on_instancing);
+
+/**
+ * @function cf_draw_get_instancing
+ * @category draw
+ * @brief    Returns true if instanced rendering of sprites and shapes is on.
+ * @related  cf_draw_set_instancing cf_draw_get_instancing cf_draw_get_stats
+ */
+CF_API bool CF_CALL cf_draw_get_instancing();
+
+/**
+ * @function cf_draw_set_parallel_threshold
+ * @category draw
+ * @brief    Sets how many items a batch needs before its vertices are generated across multiple threads.
+ * @param    item_count  The number of sprites/shapes in a single batch. Defaults to 8192. Set to 0 to always use a single thread.
+ * @remarks  Large batches are split into contiguous ranges and filled by the app's threadpool, with the calling thread helping out.
+ *           Each range writes its own slice of the vertex buffer, so the output is identical to filling it on one thread. Nothing
+ *           happens in parallel on single-core machines.
+ * @related  cf_draw_set_parallel_threshold cf_draw_get_parallel_threshold cf_draw_get_stats
+ */
+CF_API void CF_CALL cf_draw_set_parallel_threshold(int item_count);
+
+/**
+ * @function cf_draw_get_parallel_threshold
+ * @category draw
+ * @brief    Returns the number of items a batch needs before its vertices are generated across multiple threads.
+ * @related  cf_draw_set_parallel_threshold cf_draw_get_parallel_threshold
+ */
+CF_API int CF_CALL cf_draw_get_parallel_threshold();
+
+/**
+ * @function cf_draw_set_batch_reordering
+ * @category draw
+ * @brief    Turns reordering of draw commands within each layer on or off. Off by default.
+ * @param    true_turn_on_reordering  True to group commands with matching state together before batching.
+ * @remarks  Normally everything within a layer is drawn in the exact order it was submitted, so interleaving draws with different
+ *           shaders, render states or scissors breaks the layer up into many batches. With reordering on, commands sharing the same
+ *           state are pulled together, but only past commands they don't overlap on screen. Overlapping draws still come out in
+ *           submission order, so the final image is unchanged. Uniforms, viewport changes and canvases drawn with `cf_draw_canvas` are
+ *           never reordered across. Check `CF_DrawStats::batches_saved` with `cf_draw_get_stats` to see whether it pays off.
+ * @related  cf_draw_set_batch_reordering cf_draw_get_batch_reordering cf_draw_push_layer cf_draw_get_stats
+ */
+CF_API void CF_CALL cf_draw_set_batch_reordering(bool true_turn_on_reordering);
+
+/**
+ * @function cf_draw_get_batch_reordering
+ * @category draw
+ * @brief    Returns true if draw commands are reordered within each layer to reduce batches.
+ * @related  cf_draw_set_batch_reordering cf_draw_get_batch_reordering cf_draw_get_stats
+ */
+CF_API bool CF_CALL cf_draw_get_batch_reordering();
+
+/**
+ * @function cf_draw_set_vertex_scissor
+ * @category draw
+ * @brief    Turns per-vertex scissor rectangles on or off. Off by default.
+ * @param    true_turn_on_vertex_scissor  True to clip each sprite/shape with its own scissor rectangle inside the shader.
+ * @remarks  Normally each scissor pushed with `cf_draw_push_scissor` is applied as a hardware scissor, so every change of scissor
+ *           splits up the batch. UI with many clipped panels can end up with one draw call per panel. With this on, the scissor is
+ *           stored on each vertex and applied with clip distances in the vertex shader, letting differently clipped items share a
+ *           single batch. The hardware scissor is then only used when drawing canvases with `cf_draw_canvas`. Each vertex grows by
+ *           8 bytes either way, so the only cost of turning this on is a little extra clipping work on the GPU.
+ * @related  cf_draw_set_vertex_scissor cf_draw_get_vertex_scissor cf_draw_push_scissor cf_draw_get_stats
+ */
+CF_API void CF_CALL cf_draw_set_vertex_scissor(bool true_turn_on_vertex_scissor);
+
+/**
+ * @function cf_draw_get_vertex_scissor
+ * @category draw
+ * @brief    Returns true if scissor rectangles are applied per-vertex instead of with the hardware scissor.
+ * @related  cf_draw_set_vertex_scissor cf_draw_get_vertex_scissor cf_draw_push_scissor
+ */
+CF_API bool CF_CALL cf_draw_get_vertex_scissor();
+
+/**
+ * @function cf_draw_get_stats
+ * @category draw
+ * @brief    Returns `CF_DrawStats` for the previous frame.
+ * @remarks  Stats are gathered across all calls to `cf_render_to` and reset by `cf_app_draw_onto_screen`.
+ * @related  CF_DrawStats cf_draw_get_stats cf_app_draw_onto_screen
+ */
+CF_API CF_DrawStats CF_CALL cf_draw_get_stats();
+
+/**
+ * @function cf_draw_capture_begin
+ * @category draw
+ * @brief    Starts capturing everything drawn by `cf_render_to` (and `cf_app_draw_onto_screen`) until `cf_draw_capture_end`.
+ * @remarks  Captures record the final batches of a frame: their vertices, render states, uniforms and atlas texture sizes. Replay
+ *           them with `cf_draw_replay_capture` to reproduce a real frame's rendering workload, e.g. to compare `CF_DrawStats` or frame
+ *           times between two versions of the framework. Typically you'd call this right before `cf_app_draw_onto_screen` and call
+ *           `cf_draw_capture_end` right after.
+ * @related  cf_draw_capture_begin cf_draw_capture_end cf_draw_replay_capture cf_draw_get_stats
+ */
+CF_API void CF_CALL cf_draw_capture_begin();
+
+/**
+ * @function cf_draw_capture_end
+ * @category draw
+ * @brief    Stops capturing started by `cf_draw_capture_begin` and saves the capture to a file.
+ * @param    path       Virtual path of the capture file, see `cf_fs_set_write_directory`.
+ * @return   Returns any errors as a `CF_Result`.
+ * @remarks  The file is a binary container (see `CF_BinaryReader`) in native byte order, so it's meant to be replayed on the same
+ *           kind of machine it was captured on. Texture contents aren't stored, and texture uniforms set with `cf_draw_set_texture`
+ *           are skipped.
+ * @related  cf_draw_capture_begin cf_draw_capture_end cf_draw_replay_capture
+ */
+CF_API CF_Result CF_CALL cf_draw_capture_end(const char* path);
+
+/**
+ * @function cf_draw_replay_capture
+ * @category draw
+ * @brief    Replays a capture saved by `cf_draw_capture_end` onto a canvas.
+ * @param    path       Virtual path of the capture file.
+ * @param    canvas     The canvas to draw onto, usually `cf_app_get_canvas`.
+ * @return   Returns any errors as a `CF_Result`, such as a capture made with an incompatible version of the framework.
+ * @remarks  Each captured `cf_render_to` call is uploaded and drawn again batch by batch, counting towards `CF_DrawStats` like any
+ *           other frame. Atlases are replaced with blank textures of the same size, and custom shaders from `cf_make_draw_shader`
+ *           with the built-in ones, so the image won't look like the original but the amount of work done is the same. The blank
+ *           textures are made on the first replay and reused by later ones. Pair this with `APP_OPTIONS_GFX_NULL_BIT` to measure
+ *           CPU-side costs alone.
+ * @related  cf_draw_capture_begin cf_draw_capture_end cf_draw_replay_capture cf_draw_get_stats
+ */
+CF_API CF_Result CF_CALL cf_draw_replay_capture(const char* path, CF_Canvas canvas);
+
+/**
+ * @struct   CF_DrawList
+ * @category draw
+ * @brief    An opaque handle to a retained list of draw commands, recorded once and replayed many times.
+ * @remarks  Record static content (e.g. a level's background) between `cf_draw_list_begin` and `cf_draw_list_end`, then call
+ *           `cf_draw_list_submit` each frame instead of re-issuing every draw call. Submitting skips all of the per-item work
+ *           done by functions like `cf_draw_sprite` or `cf_draw_box`, and only transforms each item's vertices by a new matrix.
+ *           Lists store image ids instead of atlas coordinates, so they stay valid as atlas pages are built or defragmented.
+ * @related  CF_DrawList cf_make_draw_list cf_destroy_draw_list cf_draw_list_begin cf_draw_list_end cf_draw_list_submit
+ */
+typedef struct CF_DrawList { uint64_t id; } CF_DrawList;
+// @end
+
+/**
+ * @function cf_make_draw_list
+ * @category draw
+ * @brief    Returns a new, empty `CF_DrawList`.
+ * @remarks  Free it up with `cf_destroy_draw_list` when done.
+ * @related  CF_DrawList cf_make_draw_list cf_destroy_draw_list cf_draw_list_begin cf_draw_list_end cf_draw_list_submit
+ */
+CF_API CF_DrawList CF_CALL cf_make_draw_list();
+
+/**
+ * @function cf_destroy_draw_list
+ * @category draw
+ * @brief    Frees up all resources used by a `CF_DrawList`.
+ * @param    list       The list.
+ * @related  CF_DrawList cf_make_draw_list cf_destroy_draw_list cf_draw_list_begin cf_draw_list_end cf_draw_list_submit
+ */
+CF_API void CF_CALL cf_destroy_draw_list(CF_DrawList list);
+
+/**
+ * @function cf_draw_list_begin
+ * @category draw
+ * @brief    Starts recording all following draw calls into `list` instead of drawing them.
+ * @param    list       The list. Anything previously recorded into it is thrown away.
+ * @remarks  Every draw call up to `cf_draw_list_end` is captured, including state changes such as layers, shaders, render states,
+ *           scissors, viewports, uniforms and canvases drawn with `cf_draw_canvas`. The list is recorded relative to the camera active
+ *           right now, see `cf_draw_list_submit`. Culling (`cf_draw_push_culling`) is ignored while recording, since the list may later
+ *           be submitted anywhere. Lists can't be nested, and `cf_render_to` must not be called while recording.
+ * @related  CF_DrawList cf_make_draw_list cf_destroy_draw_list cf_draw_list_begin cf_draw_list_end cf_draw_list_submit
+ */
+CF_API void CF_CALL cf_draw_list_begin(CF_DrawList list);
+
+/**
+ * @function cf_draw_list_end
+ * @category draw
+ * @brief    Stops recording the list started by `cf_draw_list_begin`.
+ * @remarks  Draw state (layers, shaders, etc.) pushed while recording is left as-is, so balance your push/pop calls within the recording.
+ * @related  CF_DrawList cf_make_draw_list cf_destroy_draw_list cf_draw_list_begin cf_draw_list_end cf_draw_list_submit
+ */
+CF_API void CF_CALL cf_draw_list_end();
+
+/**
+ * @function cf_draw_list_submit
+ * @category draw
+ * @brief    Draws everything recorded in `list`.
+ * @param    list       The list.
+ * @param    transform  Applied to the recorded geometry before the current camera, pass `cf_make_identity()` to draw the list where it was recorded.
+ * @remarks  The recorded geometry is mapped back out of the camera active during `cf_draw_list_begin`, transformed by `transform`, then
+ *           put through the current camera. Moving the camera therefore moves the list just like it would normal draw calls. Recorded
+ *           commands keep their own layers, so a list can be drawn beneath or above other draw calls. Anti-aliasing widths are baked in
+ *           at record time, so heavily scaling a list of shapes will scale their soft edges as well. Culling applies to submitted items
+ *           as usual, see `cf_draw_push_culling`.
+ * @related  CF_DrawList cf_make_draw_list cf_destroy_draw_list cf_draw_list_begin cf_draw_list_end cf_draw_list_submit
+ */
+CF_API void CF_CALL cf_draw_list_submit(CF_DrawList list, CF_M3x2 transform);
+
 /**
  * @struct   CF_TemporaryImage
  * @category draw
@@ -1604,6 +1945,7 @@ using TemporaryImage = CF_TemporaryImage;
 
 CF_INLINE void draw_sprite(const Sprite* sprite) { cf_draw_sprite(sprite); }
 CF_INLINE void draw_sprite(const Sprite& sprite) { cf_draw_sprite(&sprite); }
+CF_INLINE void draw_sprites(const CF_Sprite* sprites, int count) { cf_draw_sprites(sprites, count); }
 CF_INLINE void draw_quad(Aabb bb, float thickness = 1.0f, float chubbiness = 0) { cf_draw_quad(bb, thickness, chubbiness); }
 CF_INLINE void draw_quad(v2 p0, v2 p1, v2 p2, v2 p3, float thickness = 1.0f, float chubbiness = 0) { cf_draw_quad2(p0, p1, p2, p3, thickness, chubbiness); }
 CF_INLINE void draw_quad_fill(Aabb bb, float chubbiness = 0) { cf_draw_quad_fill(bb, chubbiness); }
@@ -1620,6 +1962,7 @@ CF_INLINE void draw_circle(Circle circle, float thickness = 1.0f) { cf_draw_circ
 CF_INLINE void draw_circle(v2 p, float r, float thickness = 1.0f) { cf_draw_circle2(p, r, thickness); }
 CF_INLINE void draw_circle_fill(Circle circle) { cf_draw_circle_fill(circle); }
 CF_INLINE void draw_circle_fill(v2 p, float r) { cf_draw_circle_fill2(p, r); }
+CF_INLINE void draw_circles_fill(const v2* centers, const float* radii, int count) { cf_draw_circles_fill(centers, radii, count); }
 CF_INLINE void draw_capsule(Capsule capsule, float thickness = 1.0f) { cf_draw_capsule(capsule, thickness); }
 CF_INLINE void draw_capsule(v2 p0, v2 p1, float r, float thickness = 1.0f) { cf_draw_capsule2(p0, p1, r, thickness); }
 CF_INLINE void draw_capsule_fill(Capsule capsule) { cf_draw_capsule_fill(capsule); }
@@ -1630,6 +1973,8 @@ CF_INLINE void draw_line(v2 p0, v2 p1, float thickness = 1.0f) { cf_draw_line(p0
 CF_INLINE void draw_polyline(v2* points, int count, float thickness = 1.0f, bool loop = false) { cf_draw_polyline(points, count, thickness, loop); }
 CF_INLINE void draw_polygon_fill(CF_V2* points, int count, float chubbiness) { cf_draw_polygon_fill(points, count, chubbiness); }
 CF_INLINE void draw_polygon_fill_simple(CF_V2* points, int count) { cf_draw_polygon_fill_simple(points, count); }
+CF_INLINE void draw_set_tessellation_cache(bool true_turn_on_cache) { cf_draw_set_tessellation_cache(true_turn_on_cache); }
+CF_INLINE bool draw_get_tessellation_cache() { return cf_draw_get_tessellation_cache(); }
 CF_INLINE void draw_bezier_line(v2 a, v2 c0, v2 b, int iters, float thickness) { cf_draw_bezier_line(a, c0, b, iters, thickness); }
 CF_INLINE void draw_bezier_line(v2 a, v2 c0, v2 c1, v2 b, int iters, float thickness) { cf_draw_bezier_line2(a, c0, c1, b, iters, thickness); }
 CF_INLINE void draw_arrow(v2 a, v2 b, float thickness, float arrow_width) { cf_draw_arrow(a, b, thickness, arrow_width); }
@@ -1646,6 +1991,9 @@ CF_INLINE bool draw_peek_antialias() { return cf_draw_peek_antialias(); }
 CF_INLINE void draw_push_antialias_scale(float scale) { return cf_draw_push_antialias_scale(scale); }
 CF_INLINE float draw_pop_antialias_scale() { return cf_draw_pop_antialias_scale(); }
 CF_INLINE float draw_peek_antialias_scale() { return cf_draw_peek_antialias_scale(); }
+CF_INLINE void draw_push_culling(bool cull) { cf_draw_push_culling(cull); }
+CF_INLINE bool draw_pop_culling() { return cf_draw_pop_culling(); }
+CF_INLINE bool draw_peek_culling() { return cf_draw_peek_culling(); }
 CF_INLINE void draw_push_vertex_attributes(float r, float g, float b, float a) { cf_draw_push_vertex_attributes(r, g, b, a); }
 CF_INLINE void draw_push_vertex_attributes(Color attributes) { cf_draw_push_vertex_attributes2(attributes); }
 CF_INLINE Color draw_pop_vertex_attributes() { return cf_draw_pop_vertex_attributes(); }
@@ -1773,6 +2121,27 @@ CF_INLINE void draw_canvas(CF_Canvas canvas, float x, float y, float sx, float s
 
 CF_INLINE void render_to(Canvas canvas, bool clear = false) { cf_render_to(canvas, clear); }
 
+using DrawStats = CF_DrawStats;
+CF_INLINE void draw_set_instancing(bool true_turn_on_instancing) { cf_draw_set_instancing(true_turn_on_instancing); }
+CF_INLINE bool draw_get_instancing() { return cf_draw_get_instancing(); }
+CF_INLINE void draw_set_parallel_threshold(int item_count) { cf_draw_set_parallel_threshold(item_count); }
+CF_INLINE int draw_get_parallel_threshold() { return cf_draw_get_parallel_threshold(); }
+CF_INLINE void draw_set_batch_reordering(bool true_turn_on_reordering) { cf_draw_set_batch_reordering(true_turn_on_reordering); }
+CF_INLINE bool draw_get_batch_reordering() { return cf_draw_get_batch_reordering(); }
+CF_INLINE void draw_set_vertex_scissor(bool true_turn_on_vertex_scissor) { cf_draw_set_vertex_scissor(true_turn_on_vertex_scissor); }
+CF_INLINE bool draw_get_vertex_scissor() { return cf_draw_get_vertex_scissor(); }
+CF_INLINE DrawStats draw_get_stats() { return cf_draw_get_stats(); }
+CF_INLINE void draw_capture_begin() { cf_draw_capture_begin(); }
+CF_INLINE Result draw_capture_end(const char* path) { return cf_draw_capture_end(path); }
+CF_INLINE Result draw_replay_capture(const char* path, Canvas canvas) { return cf_draw_replay_capture(path, canvas); }
+
+using DrawList = CF_DrawList;
+CF_INLINE DrawList make_draw_list() { return cf_make_draw_list(); }
+CF_INLINE void destroy_draw_list(DrawList list) { cf_destroy_draw_list(list); }
+CF_INLINE void draw_list_begin(DrawList list) { cf_draw_list_begin(list); }
+CF_INLINE void draw_list_end() { cf_draw_list_end(); }
+CF_INLINE void draw_list_submit(DrawList list, M3x2 transform = cf_make_identity()) { cf_draw_list_submit(list, transform); }
+
 CF_INLINE TemporaryImage fetch_image(const Sprite* sprite) { return cf_fetch_image(sprite); }
 CF_INLINE TemporaryImage fetch_image(const Sprite& sprite) { return cf_fetch_image(&sprite); }
 
@@ -144,6 +144,8 @@ typedef struct CF_Shader { uint64_t id; } CF_Shader;
 	CF_ENUM(BACKEND_TYPE_METAL,  3)                                                \
 	/* @entry A "secret" backend for platforms under non-disclosure agreement. */  \
 	CF_ENUM(BACKEND_TYPE_PRIVATE,  4)                                           \
+	/* @entry Headless backend that records resource and draw calls without a GPU. See `APP_OPTIONS_GFX_NULL_BIT`. */ \
+	CF_ENUM(BACKEND_TYPE_NULL,  5)                                                 \
 	/* @end */
 
 typedef enum CF_BackendType
@@ -919,6 +921,7 @@ CF_API CF_Mesh CF_CALL cf_make_mesh(int vertex_buffer_size_in_bytes, const CF_Ve
  * @param    mesh                         The mesh.
  * @param    index_buffer_size_in_bytes   The size of the mesh's index buffer.
  * @param    index_bit_count              The number of bits to use for indices, must be either 16 or 32.
+ * @remarks  Calling this again on the same mesh replaces the previous index buffer, e.g. to switch from 16 to 32-bit indices.
  * @related  CF_Mesh cf_make_mesh cf_mesh_update_index_data
  */
 CF_API void CF_CALL cf_mesh_set_index_buffer(CF_Mesh mesh, int index_buffer_size_in_bytes, int index_bit_count);
@@ -1669,7 +1672,9 @@ CF_API void CF_CALL cf_draw_elements();
  * @function cf_commit
  * @category graphics
  * @brief    Submits all previous draw commands to the GPU.
- * @remarks  You must call this after calling `cf_apply_shader` to "complete" the rendering pass.
+ * @remarks  You must call this after calling `cf_apply_shader` to "complete" the rendering pass. Draws onto the same canvas share one
+ *           render pass until `cf_commit` is called, so it's best to call this once after your last draw onto a canvas rather than after
+ *           each draw. The pass is also ended automatically when switching canvases with `cf_apply_canvas`.
  * @related  CF_Canvas cf_apply_canvas cf_apply_mesh cf_apply_shader
  */
 CF_API void CF_CALL cf_commit();
@@ -551,6 +551,54 @@ extern "C" {
  */
 #define sbool(s, b) cf_string_bool(s, b)
 
+/**
+ * @function sappend_int
+ * @category string
+ * @brief    Converts an int64_t to text and appends it onto the string.
+ * @param    s            The string. Can be `NULL`.
+ * @param    i            The value to convert.
+ * @remarks  Unlike `sint` this doesn't parse a format string or call into the C runtime, and it appends instead of assigns.
+ *           Prefer this when building up text every frame, such as debug HUDs or serialized data.
+ * @related  sappend_int sappend_uint sappend_float sappend_double cf_sparse_int cf_sparse_float
+ */
+#define sappend_int(s, i) cf_string_append_int(s, i)
+
+/**
+ * @function sappend_uint
+ * @category string
+ * @brief    Converts a uint64_t to text and appends it onto the string.
+ * @param    s            The string. Can be `NULL`.
+ * @param    uint         The value to convert.
+ * @remarks  Unlike `suint` this doesn't parse a format string or call into the C runtime, and it appends instead of assigns.
+ * @related  sappend_int sappend_uint sappend_float sappend_double cf_sparse_int cf_sparse_float
+ */
+#define sappend_uint(s, uint) cf_string_append_uint(s, uint)
+
+/**
+ * @function sappend_float
+ * @category string
+ * @brief    Converts a float to text and appends it onto the string.
+ * @param    s            The string. Can be `NULL`.
+ * @param    f            The value to convert.
+ * @remarks  Writes the shortest text that parses back to exactly the same float, e.g. `0.1f` becomes "0.1" and `1.0f`
+ *           becomes "1". Always uses '.' as the decimal point regardless of locale. Infinities and NaN are written as
+ *           "inf", "-inf" and "nan".
+ * @related  sappend_int sappend_uint sappend_float sappend_double cf_sparse_int cf_sparse_float
+ */
+#define sappend_float(s, f) cf_string_append_float(s, f)
+
+/**
+ * @function sappend_double
+ * @category string
+ * @brief    Converts a double to text and appends it onto the string.
+ * @param    s            The string. Can be `NULL`.
+ * @param    d            The value to convert.
+ * @remarks  Writes the shortest text that parses back to exactly the same double. Always uses '.' as the decimal point
+ *           regardless of locale.
+ * @related  sappend_int sappend_uint sappend_float sappend_double cf_sparse_int cf_sparse_float
+ */
+#define sappend_double(s, d) cf_string_append_double(s, d)
+
 /**
  * @function stoint
  * @category string
@@ -607,6 +655,57 @@ extern "C" {
  */
 #define stobool(s) cf_string_tobool(s)
 
+/**
+ * @function cf_sparse_int
+ * @category string
+ * @brief    Parses an integer from the beginning of some text.
+ * @param    s            The text.
+ * @param    end          One past the last character of the text, or `NULL` if `s` is nul-terminated.
+ * @param    value        Set to the parsed value.
+ * @return   Returns a pointer one past the last character parsed, or `NULL` if `s` doesn't start with an integer (or it
+ *           doesn't fit in an int64_t).
+ * @example > Parsing a list of numbers.
+ *     const char* text = "10 -20 30";
+ *     int64_t value;
+ *     while ((text = cf_sparse_int(text, NULL, &value))) {
+ *         printf("%d\n", (int)value);
+ *         while (*text == ' ') ++text;
+ *     }
+ * @remarks  Accepts an optional leading '+' or '-' followed by decimal digits. Doesn't skip whitespace, doesn't allocate
+ *           and isn't affected by the C locale. Unlike `stoint`, trailing characters are fine; the return value says
+ *           where parsing stopped.
+ * @related  cf_sparse_int cf_sparse_float cf_sparse_double stoint sappend_int
+ */
+CF_API const char* CF_CALL cf_sparse_int(const char* s, const char* end, int64_t* value);
+
+/**
+ * @function cf_sparse_float
+ * @category string
+ * @brief    Parses a float from the beginning of some text.
+ * @param    s            The text.
+ * @param    end          One past the last character of the text, or `NULL` if `s` is nul-terminated.
+ * @param    value        Set to the parsed value.
+ * @return   Returns a pointer one past the last character parsed, or `NULL` if `s` doesn't start with a number.
+ * @remarks  Accepts an optional leading '+' or '-', decimal or scientific notation, "inf" and "nan". Always uses '.' as
+ *           the decimal point regardless of locale. Values out of range return `NULL`. Round-trips exactly with the
+ *           text written by `sappend_float`.
+ * @related  cf_sparse_int cf_sparse_float cf_sparse_double stofloat sappend_float
+ */
+CF_API const char* CF_CALL cf_sparse_float(const char* s, const char* end, float* value);
+
+/**
+ * @function cf_sparse_double
+ * @category string
+ * @brief    Parses a double from the beginning of some text.
+ * @param    s            The text.
+ * @param    end          One past the last character of the text, or `NULL` if `s` is nul-terminated.
+ * @param    value        Set to the parsed value.
+ * @return   Returns a pointer one past the last character parsed, or `NULL` if `s` doesn't start with a number.
+ * @remarks  Same as `cf_sparse_float`, but for doubles.
+ * @related  cf_sparse_int cf_sparse_float cf_sparse_double stodouble sappend_double
+ */
+CF_API const char* CF_CALL cf_sparse_double(const char* s, const char* end, double* value);
+
 /**
  * @function sreplace
  * @category string
@@ -704,7 +803,7 @@ extern "C" {
  *           
  *           If an invalid codepoint is found the "replacement character" 0xFFFD will be appended instead, which
  *           looks like question mark inside of a dark diamond.
- * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF16
+ * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF16 cf_decode_UTF8_bulk sappend_UTF16
  */
 #define sappend_UTF8(s, codepoint) cf_string_append_UTF8(s, codepoint)
 
@@ -725,7 +824,7 @@ extern "C" {
  * @remarks  You can use this function in a loop to decode one codepoint at a time, where each codepoint
  *           represents a single UTF8 character. If the decoded codepoint is invalid then the "replacement character"
  *           0xFFFD will be recorded instead.
- * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF16
+ * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF16 cf_decode_UTF8_bulk sappend_UTF16
  */
 CF_API const char* CF_CALL cf_decode_UTF8(const char* s, int* codepoint);
 
@@ -764,10 +863,231 @@ CF_API const char* CF_CALL cf_decode_UTF8(const char* s, int* codepoint);
  *           return s;
  *           }
  *           ```
- * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF16
+ * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF16 cf_decode_UTF8_bulk sappend_UTF16
  */
 CF_API const uint16_t* CF_CALL cf_decode_UTF16(const uint16_t* s, int* codepoint);
 
+/**
+ * @function cf_decode_UTF8_bulk
+ * @category string
+ * @brief    Decodes an entire range of UTF8 text into UTF32 codepoints at once.
+ * @param    s            The UTF8 text.
+ * @param    len          The number of bytes in `s` to decode.
+ * @param    codepoints   Array to write the decoded codepoints to. Must have room for at least `len` codepoints.
+ * @return   Returns the number of codepoints written to `codepoints`.
+ * @example > Decoding a whole string up front.
+ *     int len = (int)CF_STRLEN(text);
+ *     int* codepoints = (int*)cf_alloc(sizeof(int) * len);
+ *     int count = cf_decode_UTF8_bulk(text, len, codepoints);
+ *     for (int i = 0; i < count; ++i) {
+ *         DoSomethingWithCodepoint(codepoints[i]);
+ *     }
+ *     cf_free(codepoints);
+ * @remarks  Produces the same codepoints as calling `cf_decode_UTF8` in a loop, but runs of ASCII are decoded 16 bytes
+ *           at a time with SIMD. Nul bytes are decoded like any other character, and `s` is never read past `len` bytes.
+ *           A character cut off by the end of the range decodes as the "replacement character" 0xFFFD.
+ * @related  sappend_UTF8 cf_decode_UTF8 cf_decode_UTF8_bulk sappend_UTF16
+ */
+CF_API int CF_CALL cf_decode_UTF8_bulk(const char* s, int len, int* codepoints);
+
+/**
+ * @function sappend_UTF16
+ * @category string
+ * @brief    Transcodes a UTF16 string to UTF8 and appends it onto the string.
+ * @param    s            The string. Can be `NULL`.
+ * @param    text         The UTF16 text.
+ * @param    len          The number of `uint16_t` code units in `text`, or -1 if `text` is nul-terminated.
+ * @example > Converting a UTF16 string to UTF8.
+ *     char* s = NULL;
+ *     sappend_UTF16(s, utf16_text, -1);
+ *     printf("%s\n", s);
+ *     sfree(s);
+ * @remarks  This is a bulk version of calling `cf_decode_UTF16` and `sappend_UTF8` in a loop. The string grows at most
+ *           once, and runs of ASCII are transcoded 8 code units at a time with SIMD. Unpaired surrogates are appended
+ *           as the "replacement character" 0xFFFD.
+ * @related  sappend_UTF8 sappend_UTF16 cf_decode_UTF16 cf_decode_UTF8_bulk
+ */
+#define sappend_UTF16(s, text, len) cf_string_append_UTF16(s, text, len)
+
+//--------------------------------------------------------------------------------------------------
+// String builder.
+
+/**
+ * @struct   CF_StringChunk
+ * @category string
+ * @brief    One contiguous piece of the text held by a `CF_StringBuilder`.
+ * @remarks  Chunks are not nul-terminated. Get them with `cf_string_builder_chunks`.
+ * @related  CF_StringBuilder CF_StringChunk cf_string_builder_chunks
+ */
+typedef struct CF_StringChunk
+{
+	/* @member The characters of this chunk. Not nul-terminated. */
+	char* data;
+
+	/* @member Number of characters in `data`. */
+	int len;
+} CF_StringChunk;
+// @end
+
+/**
+ * @struct   CF_StringBuilder
+ * @category string
+ * @brief    Builds up a long string out of many small appends without reallocating.
+ * @remarks  Text is appended into fixed-size chunks carved out of an arena, so nothing ever gets moved or reallocated
+ *           while building. When finished, grab one contiguous copy with `cf_string_builder_to_string`, or walk the
+ *           pieces in place with `cf_string_builder_chunks`. Call `cf_string_builder_clear` to start over while keeping
+ *           all the memory around, e.g. once per frame for a debug overlay.
+ * @example > Building a debug overlay string once per frame.
+ *     CF_StringBuilder sb;
+ *     cf_string_builder_init(&sb, 0);
+ *     while (running) {
+ *         cf_string_builder_clear(&sb);
+ *         cf_string_builder_append(&sb, "fps: ");
+ *         cf_string_builder_append_float(&sb, fps);
+ *         cf_string_builder_fmt(&sb, "\nentities: %d", entity_count);
+ *         char* s = cf_string_builder_to_string(&sb);
+ *         draw_text(s);
+ *         sfree(s);
+ *     }
+ *     cf_string_builder_destroy(&sb);
+ * @related  CF_StringBuilder cf_string_builder_init cf_string_builder_destroy cf_string_builder_clear cf_string_builder_append cf_string_builder_to_string
+ */
+typedef struct CF_StringBuilder
+{
+	/* @member For internal use. Don't touch. Memory for the chunks. */
+	CF_Arena arena;
+
+	/* @member For internal use. Don't touch. Capacity of each chunk. */
+	int chunk_size;
+
+	/* @member For internal use. Don't touch. Number of chunks holding text. */
+	int chunk_count;
+
+	/* @member Total number of characters appended so far. */
+	int len;
+
+	/* @member For internal use. Don't touch. Dynamic array of all chunks, including unused ones kept for reuse. */
+	CF_StringChunk* chunks;
+} CF_StringBuilder;
+// @end
+
+/**
+ * @function cf_string_builder_init
+ * @category string
+ * @brief    Initializes a string builder.
+ * @param    sb           The string builder.
+ * @param    chunk_size   The size of each chunk in bytes, or 0 to use a default of 4096.
+ * @remarks  Free it up with `cf_string_builder_destroy` when done.
+ * @related  CF_StringBuilder cf_string_builder_init cf_string_builder_destroy cf_string_builder_clear
+ */
+CF_API void CF_CALL cf_string_builder_init(CF_StringBuilder* sb, int chunk_size);
+
+/**
+ * @function cf_string_builder_destroy
+ * @category string
+ * @brief    Frees up all memory used by a string builder.
+ * @param    sb           The string builder.
+ * @related  CF_StringBuilder cf_string_builder_init cf_string_builder_destroy cf_string_builder_clear
+ */
+CF_API void CF_CALL cf_string_builder_destroy(CF_StringBuilder* sb);
+
+/**
+ * @function cf_string_builder_clear
+ * @category string
+ * @brief    Removes all text from the string builder, but keeps its memory around for reuse.
+ * @param    sb           The string builder.
+ * @related  CF_StringBuilder cf_string_builder_init cf_string_builder_destroy cf_string_builder_clear
+ */
+CF_API void CF_CALL cf_string_builder_clear(CF_StringBuilder* sb);
+
+/**
+ * @function cf_string_builder_append
+ * @category string
+ * @brief    Appends a nul-terminated string.
+ * @param    sb           The string builder.
+ * @param    s            The string to append.
+ * @related  CF_StringBuilder cf_string_builder_append cf_string_builder_append_range cf_string_builder_fmt cf_string_builder_append_int cf_string_builder_append_float
+ */
+CF_API void CF_CALL cf_string_builder_append(CF_StringBuilder* sb, const char* s);
+
+/**
+ * @function cf_string_builder_append_range
+ * @category string
+ * @brief    Appends a range of characters.
+ * @param    sb           The string builder.
+ * @param    start        The first character to append.
+ * @param    end          One past the last character to append.
+ * @related  CF_StringBuilder cf_string_builder_append cf_string_builder_append_range cf_string_builder_fmt cf_string_builder_append_int cf_string_builder_append_float
+ */
+CF_API void CF_CALL cf_string_builder_append_range(CF_StringBuilder* sb, const char* start, const char* end);
+
+/**
+ * @function cf_string_builder_fmt
+ * @category string
+ * @brief    Appends printf-style formatted text.
+ * @param    sb           The string builder.
+ * @param    fmt          The format string.
+ * @param    ...          The arguments for the format string.
+ * @remarks  The text is formatted straight into the current chunk when it fits.
+ * @related  CF_StringBuilder cf_string_builder_append cf_string_builder_append_range cf_string_builder_fmt cf_string_builder_append_int cf_string_builder_append_float
+ */
+CF_API void CF_CALL cf_string_builder_fmt(CF_StringBuilder* sb, const char* fmt, ...);
+
+/**
+ * @function cf_string_builder_append_int
+ * @category string
+ * @brief    Appends an int64_t as text.
+ * @param    sb           The string builder.
+ * @param    i            The value to append.
+ * @remarks  Same formatting as `sappend_int`.
+ * @related  CF_StringBuilder cf_string_builder_append cf_string_builder_append_int cf_string_builder_append_float sappend_int
+ */
+CF_API void CF_CALL cf_string_builder_append_int(CF_StringBuilder* sb, int64_t i);
+
+/**
+ * @function cf_string_builder_append_float
+ * @category string
+ * @brief    Appends a float as text.
+ * @param    sb           The string builder.
+ * @param    f            The value to append.
+ * @remarks  Same formatting as `sappend_float`, the shortest text that round-trips.
+ * @related  CF_StringBuilder cf_string_builder_append cf_string_builder_append_int cf_string_builder_append_float sappend_float
+ */
+CF_API void CF_CALL cf_string_builder_append_float(CF_StringBuilder* sb, float f);
+
+/**
+ * @function cf_string_builder_len
+ * @category string
+ * @brief    Returns the number of characters appended so far.
+ * @param    sb           The string builder.
+ * @related  CF_StringBuilder cf_string_builder_len cf_string_builder_to_string cf_string_builder_chunks
+ */
+CF_API int CF_CALL cf_string_builder_len(const CF_StringBuilder* sb);
+
+/**
+ * @function cf_string_builder_to_string
+ * @category string
+ * @brief    Returns all the appended text as one new contiguous string.
+ * @param    sb           The string builder.
+ * @return   Returns a new dynamic string, free it with `sfree` when done.
+ * @remarks  The string is allocated exactly once at its final size.
+ * @related  CF_StringBuilder cf_string_builder_len cf_string_builder_to_string cf_string_builder_chunks
+ */
+CF_API char* CF_CALL cf_string_builder_to_string(const CF_StringBuilder* sb);
+
+/**
+ * @function cf_string_builder_chunks
+ * @category string
+ * @brief    Returns the appended text as a list of chunks, without copying anything.
+ * @param    sb           The string builder.
+ * @param    count        Set to the number of chunks.
+ * @return   Returns an array of `count` chunks. Concatenated in order they form the full text.
+ * @remarks  Use this to write the text somewhere (e.g. a file or socket) without first making a contiguous copy.
+ *           The chunks are invalidated by any further appends, `cf_string_builder_clear` or `cf_string_builder_destroy`.
+ * @related  CF_StringBuilder CF_StringChunk cf_string_builder_len cf_string_builder_to_string cf_string_builder_chunks
+ */
+CF_API const CF_StringChunk* CF_CALL cf_string_builder_chunks(const CF_StringBuilder* sb, int* count);
+
 //--------------------------------------------------------------------------------------------------
 // String Intering C API (global string table).
 // ^      ^
@@ -889,6 +1209,10 @@ CF_API const uint16_t* CF_CALL cf_decode_UTF16(const uint16_t* s, int* codepoint
 #define cf_string_double(s, f) cf_string_fmt(s, "%f", d)
 #define cf_string_hex(s, uint) cf_string_fmt(s, "0x%x", uint)
 #define cf_string_bool(s, b) cf_string_fmt(s, "%s", b ? "true" : "false")
+#define cf_string_append_int(s, i) (s = cf_sappend_int(s, i))
+#define cf_string_append_uint(s, uint) (s = cf_sappend_uint(s, uint))
+#define cf_string_append_float(s, f) (s = cf_sappend_float(s, f))
+#define cf_string_append_double(s, d) (s = cf_sappend_double(s, d))
 #define cf_string_toint(s) cf_stoint(s)
 #define cf_string_touint(s) cf_stouint(s)
 #define cf_string_tofloat(s) cf_stofloat(s)
@@ -904,6 +1228,7 @@ CF_API const uint16_t* CF_CALL cf_decode_UTF16(const uint16_t* s, int* codepoint
 #define cf_string_is_dynamic(s) (s && !((#s)[0] == '"') && CF_AHDR(s)->cookie == CF_ACOOKIE)
 #define cf_sinuke() cf_sinuke_intern_table()
 #define cf_string_append_UTF8(s, codepoint) (s = cf_string_append_UTF8_impl(s, codepoint))
+#define cf_string_append_UTF16(s, text, len) (s = cf_string_append_UTF16_impl(s, text, len))
 
 //--------------------------------------------------------------------------------------------------
 // Hidden API - Not intended for direct use.
@@ -930,6 +1255,10 @@ CF_API void CF_CALL cf_stoupper(char* s);
 CF_API void CF_CALL cf_stolower(char* s);
 CF_API char* CF_CALL cf_sappend(char* a, const char* b);
 CF_API char* CF_CALL cf_sappend_range(char* a, const char* b, const char* b_end);
+CF_API char* CF_CALL cf_sappend_int(char* s, int64_t i);
+CF_API char* CF_CALL cf_sappend_uint(char* s, uint64_t i);
+CF_API char* CF_CALL cf_sappend_float(char* s, float f);
+CF_API char* CF_CALL cf_sappend_double(char* s, double d);
 CF_API char* CF_CALL cf_strim(char* s);
 CF_API char* CF_CALL cf_sltrim(char* s);
 CF_API char* CF_CALL cf_srtrim(char* s);
@@ -950,6 +1279,7 @@ CF_API char* CF_CALL cf_serase(char* s, int index, int count);
 CF_API char* CF_CALL cf_spop(char* s);
 CF_API char* CF_CALL cf_spopn(char* s, int n);
 CF_API char* CF_CALL cf_string_append_UTF8_impl(char *s, int codepoint);
+CF_API char* CF_CALL cf_string_append_UTF16_impl(char* s, const uint16_t* text, int len);
 
 CF_API const char* CF_CALL cf_sintern(const char* s);
 CF_API const char* CF_CALL cf_sintern_range(const char* start, const char* end);
@@ -1093,6 +1423,31 @@ CF_INLINE String to_string(float f) { return String(f); }
 CF_INLINE String to_string(double f) { return String(f); }
 CF_INLINE String to_string(bool b) { return String(b); }
 
+/**
+ * Wrapper around `CF_StringBuilder` that cleans itself up.
+ * 
+ * Example:
+ * 
+ *     StringBuilder sb;
+ *     sb.append("x: ").append_float(x).append(", y: ").append_float(y);
+ *     String s = sb.to_string();
+ */
+struct StringBuilder : public CF_StringBuilder
+{
+	CF_INLINE StringBuilder(int chunk_size = 0) { cf_string_builder_init(this, chunk_size); }
+	CF_INLINE ~StringBuilder() { cf_string_builder_destroy(this); }
+	StringBuilder(const StringBuilder&) = delete;
+	StringBuilder& operator=(const StringBuilder&) = delete;
+
+	CF_INLINE StringBuilder& append(const char* s) { cf_string_builder_append(this, s); return *this; }
+	CF_INLINE StringBuilder& append(const char* start, const char* end) { cf_string_builder_append_range(this, start, end); return *this; }
+	CF_INLINE StringBuilder& append_int(int64_t i) { cf_string_builder_append_int(this, i); return *this; }
+	CF_INLINE StringBuilder& append_float(float f) { cf_string_builder_append_float(this, f); return *this; }
+	CF_INLINE void clear() { cf_string_builder_clear(this); }
+	CF_INLINE int size() const { return cf_string_builder_len(this); }
+	CF_INLINE String to_string() const { return String::steal_from(cf_string_builder_to_string(this)); }
+};
+
 /**
  * UTF8 decoder. Load it up with a string and read `.codepoint`. Call `next` to fetch the
  * next codepoint.
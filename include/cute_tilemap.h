@@ -0,0 +1,142 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#ifndef CF_TILEMAP_H
+#define CF_TILEMAP_H
+
+#include "cute_defines.h"
+#include "cute_math.h"
+#include "cute_sprite.h"
+
+//--------------------------------------------------------------------------------------------------
+// C API
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**
+ * @struct   CF_Tilemap
+ * @category draw
+ * @brief    An opaque handle to a grid of tiles, drawn with `cf_draw_tilemap`.
+ * @remarks  Tiles are stored in square chunks of `CF_TILEMAP_CHUNK_SIZE` tiles. The geometry for each chunk is built once and cached,
+ *           and only rebuilt when one of its tiles changes. Drawing a tilemap only submits chunks that overlap the canvas, so a large
+ *           tile layer costs about as much as the handful of chunks visible on screen. This is much cheaper than calling
+ *           `cf_draw_sprite` for each tile every frame.
+ * @related  CF_Tilemap cf_make_tilemap cf_destroy_tilemap cf_tilemap_set_tile_sprite cf_tilemap_set cf_tilemap_get cf_draw_tilemap
+ */
+typedef struct CF_Tilemap { uint64_t id; } CF_Tilemap;
+// @end
+
+/**
+ * @function CF_TILEMAP_CHUNK_SIZE
+ * @category draw
+ * @brief    The width and height, in tiles, of each chunk of a `CF_Tilemap`.
+ * @related  CF_Tilemap cf_make_tilemap cf_draw_tilemap
+ */
+#define CF_TILEMAP_CHUNK_SIZE 32
+
+/**
+ * @function cf_make_tilemap
+ * @category draw
+ * @brief    Returns a new `CF_Tilemap` with every tile empty.
+ * @param    w          The number of tiles along the x-axis.
+ * @param    h          The number of tiles along the y-axis.
+ * @param    tile_w     The width of each tile in world space.
+ * @param    tile_h     The height of each tile in world space.
+ * @remarks  Free it up with `cf_destroy_tilemap` when done. Tile (0, 0) is the bottom-left tile. A `w` or `h` less than one is
+ *           clamped to one.
+ * @related  CF_Tilemap cf_make_tilemap cf_destroy_tilemap cf_tilemap_set_tile_sprite cf_tilemap_set cf_tilemap_get cf_draw_tilemap
+ */
+CF_API CF_Tilemap CF_CALL cf_make_tilemap(int w, int h, float tile_w, float tile_h);
+
+/**
+ * @function cf_destroy_tilemap
+ * @category draw
+ * @brief    Frees up all resources used by a `CF_Tilemap`.
+ * @param    tilemap    The tilemap.
+ * @related  CF_Tilemap cf_make_tilemap cf_destroy_tilemap
+ */
+CF_API void CF_CALL cf_destroy_tilemap(CF_Tilemap tilemap);
+
+/**
+ * @function cf_tilemap_set_tile_sprite
+ * @category draw
+ * @brief    Sets which sprite is drawn for every tile with the id `tile_id`.
+ * @param    tilemap    The tilemap.
+ * @param    tile_id    The tile id, must be greater than zero. Zero is reserved for empty tiles.
+ * @param    sprite     The sprite, which is copied. Its position, scale and rotation are overwritten to fit the tile, while its current
+ *                      animation frame, opacity and offset are kept.
+ * @remarks  Every chunk is rebuilt the next time it's drawn, so call this while setting up the tilemap rather than every frame.
+ *           Animated tiles should be drawn separately with `cf_draw_sprite`, as chunks only ever hold the frame current at rebuild time.
+ * @related  CF_Tilemap cf_tilemap_set_tile_sprite cf_tilemap_set cf_tilemap_get cf_draw_tilemap
+ */
+CF_API void CF_CALL cf_tilemap_set_tile_sprite(CF_Tilemap tilemap, int tile_id, const CF_Sprite* sprite);
+
+/**
+ * @function cf_tilemap_set
+ * @category draw
+ * @brief    Sets the tile id at a tile coordinate.
+ * @param    tilemap    The tilemap.
+ * @param    x          The tile's x coordinate, from 0 to `w - 1`.
+ * @param    y          The tile's y coordinate, from 0 to `h - 1`.
+ * @param    tile_id    The tile id, or zero for an empty tile.
+ * @remarks  Only the chunk containing the tile is rebuilt, and only if the id actually changed.
+ * @related  CF_Tilemap cf_tilemap_set_tile_sprite cf_tilemap_set cf_tilemap_get cf_draw_tilemap
+ */
+CF_API void CF_CALL cf_tilemap_set(CF_Tilemap tilemap, int x, int y, int tile_id);
+
+/**
+ * @function cf_tilemap_get
+ * @category draw
+ * @brief    Returns the tile id at a tile coordinate.
+ * @param    tilemap    The tilemap.
+ * @param    x          The tile's x coordinate, from 0 to `w - 1`.
+ * @param    y          The tile's y coordinate, from 0 to `h - 1`.
+ * @related  CF_Tilemap cf_tilemap_set_tile_sprite cf_tilemap_set cf_tilemap_get cf_draw_tilemap
+ */
+CF_API int CF_CALL cf_tilemap_get(CF_Tilemap tilemap, int x, int y);
+
+/**
+ * @function cf_draw_tilemap
+ * @category draw
+ * @brief    Draws a tilemap.
+ * @param    tilemap    The tilemap.
+ * @param    position   World space position of the bottom-left corner of the tilemap.
+ * @remarks  Uses the current camera, layer, shader and other draw state just like `cf_draw_sprite`. Chunks entirely outside the canvas
+ *           are skipped, and any visible chunks with modified tiles are rebuilt before being drawn.
+ * @related  CF_Tilemap cf_make_tilemap cf_tilemap_set cf_draw_tilemap
+ */
+CF_API void CF_CALL cf_draw_tilemap(CF_Tilemap tilemap, CF_V2 position);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+//--------------------------------------------------------------------------------------------------
+// C++ API
+
+#ifdef CF_CPP
+
+namespace Cute
+{
+
+using Tilemap = CF_Tilemap;
+
+CF_INLINE Tilemap make_tilemap(int w, int h, float tile_w, float tile_h) { return cf_make_tilemap(w, h, tile_w, tile_h); }
+CF_INLINE void destroy_tilemap(Tilemap tilemap) { cf_destroy_tilemap(tilemap); }
+CF_INLINE void tilemap_set_tile_sprite(Tilemap tilemap, int tile_id, const Sprite* sprite) { cf_tilemap_set_tile_sprite(tilemap, tile_id, sprite); }
+CF_INLINE void tilemap_set_tile_sprite(Tilemap tilemap, int tile_id, const Sprite& sprite) { cf_tilemap_set_tile_sprite(tilemap, tile_id, &sprite); }
+CF_INLINE void tilemap_set(Tilemap tilemap, int x, int y, int tile_id) { cf_tilemap_set(tilemap, x, y, tile_id); }
+CF_INLINE int tilemap_get(Tilemap tilemap, int x, int y) { return cf_tilemap_get(tilemap, x, y); }
+CF_INLINE void draw_tilemap(Tilemap tilemap, v2 position) { cf_draw_tilemap(tilemap, position); }
+
+}
+
+#endif // CF_CPP
+
+#endif // CF_TILEMAP_H
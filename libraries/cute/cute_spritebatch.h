@@ -229,6 +229,10 @@ struct spritebatch_sprite_t
 // Pushes a sprite onto an internal buffer. Does no other logic.
 void spritebatch_push(spritebatch_t* sb, spritebatch_sprite_t sprite);
 
+// Pushes an array of sprites onto the internal buffer. Same as calling `spritebatch_push` on each
+// sprite, but grows the buffer at most once and doesn't pass each sprite around by value.
+void spritebatch_push_array(spritebatch_t* sb, const spritebatch_sprite_t* sprites, int count);
+
 // Ensures the image associated with your unique `image_id` is loaded up into spritebatch. This
 // function pretends to draw a sprite referencing `image_id` but doesn't actually do any
 // drawing at all. Use this function as an optimization to pre-load images you know will be
@@ -297,6 +301,9 @@ typedef struct spritebatch_premade_sprite_t
 // can become a lot simpler than flooding `spritebatch_push` with a lot of unique glyphs used briefly.
 void spritebatch_register_premade_atlas(spritebatch_t* sb, SPRITEBATCH_U64 texture_id, int w, int h, int sprite_count, spritebatch_premade_sprite_t* sprites);
 
+// Forgets a sprite registered with `spritebatch_register_premade_atlas`, e.g. before its texture is destroyed.
+void spritebatch_unregister_premade_sprite(spritebatch_t* sb, SPRITEBATCH_U64 image_id);
+
 // Sprite batches are submit via synchronous callback back to the user. This function is called
 // from inside `spritebatch_flush`. Each time `submit_batch_fn` is called an array of sprites
 // is handed to the user. The sprites are intended to be further sorted by the user as desired
@@ -1173,31 +1180,35 @@ void spritebatch_set_default_config(spritebatch_config_t* config)
 	} while (0)
 
 
-int spritebatch_internal_fill_internal_sprite(spritebatch_t* sb, spritebatch_sprite_t sprite, spritebatch_internal_sprite_t* out)
+static inline void spritebatch_internal_copy_sprite(spritebatch_t* sb, const spritebatch_sprite_t* sprite, spritebatch_internal_sprite_t* out)
 {
-	SPRITEBATCH_ASSERT(sprite.w <= sb->atlas_width_in_pixels);
-	SPRITEBATCH_ASSERT(sprite.h <= sb->atlas_height_in_pixels);
-	SPRITEBATCH_CHECK_BUFFER_GROW(sb, input_count, input_capacity, input_buffer, spritebatch_internal_sprite_t);
-
-	out->image_id = sprite.image_id;
-	out->sort_bits = sprite.sort_bits;
-	out->geom = sprite.geom;
-	out->w = sprite.w;
-	out->h = sprite.h;
+	SPRITEBATCH_ASSERT(sprite->w <= sb->atlas_width_in_pixels);
+	SPRITEBATCH_ASSERT(sprite->h <= sb->atlas_height_in_pixels);
+
+	out->image_id = sprite->image_id;
+	out->sort_bits = sprite->sort_bits;
+	out->geom = sprite->geom;
+	out->w = sprite->w;
+	out->h = sprite->h;
 #ifdef SPRITEBATCH_SPRITE_GEOMETRY_DEFAULT
-	out->geom.sx = sprite.geom.sx + (sb->atlas_use_border_pixels ? (sprite.geom.sx / (float)sprite.w) * 2.0f : 0);
-	out->geom.sy = sprite.geom.sy + (sb->atlas_use_border_pixels ? (sprite.geom.sy / (float)sprite.h) * 2.0f : 0);
+	out->geom.sx = sprite->geom.sx + (sb->atlas_use_border_pixels ? (sprite->geom.sx / (float)sprite->w) * 2.0f : 0);
+	out->geom.sy = sprite->geom.sy + (sb->atlas_use_border_pixels ? (sprite->geom.sy / (float)sprite->h) * 2.0f : 0);
 #endif
 
-	out->premade_minx = sprite.minx;
-	out->premade_miny = sprite.miny;
-	out->premade_maxx = sprite.maxx;
-	out->premade_maxy = sprite.maxy;
+	out->premade_minx = sprite->minx;
+	out->premade_miny = sprite->miny;
+	out->premade_maxx = sprite->maxx;
+	out->premade_maxy = sprite->maxy;
 
 #ifdef SPRITEBATCH_SPRITE_USERDATA
-	out->udata = sprite.udata;
+	out->udata = sprite->udata;
 #endif
+}
 
+int spritebatch_internal_fill_internal_sprite(spritebatch_t* sb, spritebatch_sprite_t sprite, spritebatch_internal_sprite_t* out)
+{
+	SPRITEBATCH_CHECK_BUFFER_GROW(sb, input_count, input_capacity, input_buffer, spritebatch_internal_sprite_t);
+	spritebatch_internal_copy_sprite(sb, &sprite, out);
 	return 1;
 }
 
@@ -1213,6 +1224,26 @@ void spritebatch_push(spritebatch_t* sb, spritebatch_sprite_t sprite)
 	sb->input_buffer[sb->input_count++] = sprite_out;
 }
 
+void spritebatch_push_array(spritebatch_t* sb, const spritebatch_sprite_t* sprites, int count)
+{
+	if (sb->input_count + count > sb->input_capacity)
+	{
+		int new_capacity = sb->input_capacity * 2;
+		while (new_capacity < sb->input_count + count) new_capacity *= 2;
+		void* new_data = SPRITEBATCH_MALLOC(sizeof(spritebatch_internal_sprite_t) * new_capacity, sb->mem_ctx);
+		if (!new_data) return;
+		SPRITEBATCH_MEMCPY(new_data, sb->input_buffer, sizeof(spritebatch_internal_sprite_t) * sb->input_count);
+		SPRITEBATCH_FREE(sb->input_buffer, sb->mem_ctx);
+		sb->input_buffer = (spritebatch_internal_sprite_t*)new_data;
+		sb->input_capacity = new_capacity;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		spritebatch_internal_copy_sprite(sb, sprites + i, sb->input_buffer + sb->input_count++);
+	}
+}
+
 void spritebatch_register_premade_atlas(spritebatch_t* sb, SPRITEBATCH_U64 texture_id, int w, int h, int sprite_count, spritebatch_premade_sprite_t* sprites)
 {
 	for (int i = 0; i < sprite_count; ++i) {
@@ -1233,6 +1264,13 @@ void spritebatch_register_premade_atlas(spritebatch_t* sb, SPRITEBATCH_U64 textu
 	}
 }
 
+void spritebatch_unregister_premade_sprite(spritebatch_t* sb, SPRITEBATCH_U64 image_id)
+{
+	if (hashtable_find(&sb->sprites_to_premades, image_id)) {
+		hashtable_remove(&sb->sprites_to_premades, image_id);
+	}
+}
+
 int spritebatch_internal_lonely_sprite(spritebatch_t* sb, SPRITEBATCH_U64 image_id, int w, int h, spritebatch_sprite_t* sprite_out, int skip_missing_textures);
 spritebatch_internal_premade_sprite_t* spritebatch_internal_premade_sprite(spritebatch_t* sb, SPRITEBATCH_U64 image_id, spritebatch_sprite_t* sprite_out);
 
@@ -0,0 +1,192 @@
+#include <cute.h>
+using namespace Cute;
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Benchmarks the CPU side of the draw API: submitting items and turning them into batches in `cf_render_to`.
+// Runs sprites, SDF shapes, polylines, text glyphs and a mixed-state scene at 1K to 1M items, and prints the
+// CPU time per frame and items per second of each as JSON. Uses the null graphics backend so no GPU or display
+// is needed, pass --gpu to measure with a real one instead.
+//
+// Usage: cute_bench_draw [max_items] [--gpu]
+
+#define MIN_FRAMES 3
+#define MAX_FRAMES 60
+#define MIN_SECONDS 0.5
+#define GLYPHS_PER_STRING 16
+#define POINTS_PER_POLYLINE 4
+
+// Whitespace draws nothing, so every one of these characters is a visible glyph.
+static const char* s_text = "TheQuickBrownFox";
+
+static Array<v2> s_positions;
+static Sprite s_sprites[4];
+
+static void s_scene_sprites(int count)
+{
+	for (int i = 0; i < count; ++i) {
+		Sprite& sprite = s_sprites[i & 3];
+		sprite.transform.p = s_positions[i];
+		draw_sprite(sprite);
+	}
+}
+
+static void s_scene_shapes(int count)
+{
+	for (int i = 0; i < count; ++i) {
+		v2 p = s_positions[i];
+		switch (i % 3) {
+		case 0: draw_circle_fill(p, 4.0f); break;
+		case 1: draw_box_fill(p, 8.0f, 6.0f, 1.0f); break;
+		case 2: draw_capsule_fill(p, p + V2(6.0f, 3.0f), 2.0f); break;
+		}
+	}
+}
+
+static void s_scene_polylines(int count)
+{
+	v2 points[POINTS_PER_POLYLINE];
+	for (int i = 0; i < count; ++i) {
+		v2 p = s_positions[i];
+		for (int j = 0; j < POINTS_PER_POLYLINE; ++j) {
+			points[j] = p + V2((float)j * 5.0f, (j & 1) ? 4.0f : 0.0f);
+		}
+		draw_polyline(points, POINTS_PER_POLYLINE, 1.5f, false);
+	}
+}
+
+static void s_scene_text(int count)
+{
+	for (int i = 0; i < count; i += GLYPHS_PER_STRING) {
+		draw_text(s_text, s_positions[i]);
+	}
+}
+
+// Interleaves sprites and shapes while changing color, layer and scissor every so often, like a busy UI or game scene.
+static void s_scene_mixed(int count)
+{
+	Color colors[4] = { color_white(), color_red(), color_green(), color_blue() };
+	for (int i = 0; i < count; ++i) {
+		if (!(i & 63)) {
+			if (i) {
+				draw_pop_scissor();
+				draw_pop_color();
+				draw_pop_layer();
+			}
+			draw_push_layer((i >> 8) & 3);
+			draw_push_color(colors[(i >> 6) & 3]);
+			int x = (i >> 6) & 7;
+			draw_push_scissor({ x * 40, 0, 320, 480 });
+		}
+		v2 p = s_positions[i];
+		switch (i & 3) {
+		case 0: s_sprites[0].transform.p = p; draw_sprite(s_sprites[0]); break;
+		case 1: draw_circle_fill(p, 4.0f); break;
+		case 2: draw_box_fill(p, 8.0f, 6.0f, 1.0f); break;
+		case 3: s_sprites[1].transform.p = p; draw_sprite(s_sprites[1]); break;
+		}
+	}
+	if (count) {
+		draw_pop_scissor();
+		draw_pop_color();
+		draw_pop_layer();
+	}
+}
+
+struct Scene
+{
+	const char* name;
+	void (*fn)(int count);
+};
+
+static void s_bench(const Scene& scene, int count, bool first)
+{
+	// Warm up caches, atlases and glyphs before timing anything.
+	app_update();
+	scene.fn(count);
+	app_draw_onto_screen(true);
+
+	double seconds = 0;
+	int frames = 0;
+	DrawStats stats = { };
+	while (frames < MAX_FRAMES && (frames < MIN_FRAMES || seconds < MIN_SECONDS)) {
+		app_update();
+		CF_Stopwatch sw = cf_make_stopwatch();
+		scene.fn(count);
+		app_draw_onto_screen(true);
+		seconds += cf_stopwatch_seconds(sw);
+		stats = draw_get_stats();
+		++frames;
+	}
+
+	double frame_seconds = seconds / frames;
+	printf("%s\n    { \"scene\": \"%s\", \"items\": %d, \"frames\": %d, \"ms_per_frame\": %.4f, \"items_per_sec\": %.0f, \"draw_calls\": %d, \"batches\": %d, \"vertex_bytes\": %llu }",
+		first ? "" : ",", scene.name, count, frames, frame_seconds * 1000.0, count / frame_seconds, stats.draw_call_count, stats.batch_count, (unsigned long long)stats.vertex_bytes);
+	fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+	int max_items = 1000000;
+	bool gpu = false;
+	for (int i = 1; i < argc; ++i) {
+		if (!CF_STRCMP(argv[i], "--gpu")) gpu = true;
+		else max_items = atoi(argv[i]);
+	}
+	if (max_items < 1000) {
+		printf("max_items must be at least 1000, the smallest item count benchmarked.\n");
+		printf("Usage: cute_bench_draw [max_items] [--gpu]\n");
+		return -1;
+	}
+
+	int options = APP_OPTIONS_HIDDEN_BIT | APP_OPTIONS_NO_AUDIO_BIT;
+	if (!gpu) options |= APP_OPTIONS_GFX_NULL_BIT;
+	Result result = make_app("Draw Benchmark", 0, 0, 0, 640, 480, options, argv[0]);
+	if (is_error(result)) {
+		printf("%s\n", result.details);
+		return -1;
+	}
+
+	// A few small procedural sprites, so the atlas holds more than a single image.
+	for (int i = 0; i < 4; ++i) {
+		Pixel pixels[16 * 16];
+		for (int j = 0; j < 16 * 16; ++j) {
+			pixels[j].colors = { (uint8_t)(64 * i), (uint8_t)(j & 0xFF), (uint8_t)(255 - 64 * i), 255 };
+		}
+		s_sprites[i] = easy_make_sprite(pixels, 16, 16);
+	}
+
+	// Random positions within the canvas, generated up front so they aren't part of the timings.
+	Rnd rnd = rnd_seed(0);
+	s_positions.ensure_count(max_items);
+	for (int i = 0; i < max_items; ++i) {
+		s_positions[i] = V2(rnd_range(rnd, -310.0f, 280.0f), rnd_range(rnd, -230.0f, 230.0f));
+	}
+
+	Scene scenes[] = {
+		{ "sprites", s_scene_sprites },
+		{ "shapes", s_scene_shapes },
+		{ "polylines", s_scene_polylines },
+		{ "text", s_scene_text },
+		{ "mixed", s_scene_mixed },
+	};
+	int counts[] = { 1000, 10000, 100000, 1000000 };
+
+	printf("{\n  \"backend\": \"%s\",\n  \"results\": [", cf_backend_type_to_string(query_backend()));
+	bool first = true;
+	for (int i = 0; i < CF_ARRAY_SIZE(scenes); ++i) {
+		for (int j = 0; j < CF_ARRAY_SIZE(counts); ++j) {
+			if (counts[j] > max_items) continue;
+			s_bench(scenes[i], counts[j], first);
+			first = false;
+		}
+	}
+	printf("\n  ]\n}\n");
+
+	for (int i = 0; i < 4; ++i) {
+		cf_easy_sprite_unload(&s_sprites[i]);
+	}
+	destroy_app();
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include <cute.h>
+using namespace Cute;
+
+#include <stdio.h>
+
+// Benchmarks decoding UTF8 one codepoint at a time with `cf_decode_UTF8` against `cf_decode_UTF8_bulk`,
+// and transcoding UTF16 to UTF8 with a `cf_decode_UTF16` + `sappend_UTF8` loop against `sappend_UTF16`.
+// Runs on a mostly-Latin corpus and a CJK corpus. No window is needed.
+
+#define CORPUS_SIZE (4 * 1024 * 1024)
+#define ITERATIONS 20
+
+static const char* s_latin_line = "The quick brown fox jumps over the lazy dog, caf\xC3\xA9 na\xC3\xAFve r\xC3\xA9sum\xC3\xA9. ";
+static const char* s_cjk_line = "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87\xE7\xAB\xA0\xE3\x81\xA7\xE3\x81\x99\xE3\x80\x82\xE4\xB8\xAD\xE6\x96\x87\xE6\xB5\x8B\xE8\xAF\x95\xE3\x80\x82";
+
+static char* s_make_corpus(const char* line)
+{
+	char* s = NULL;
+	while (slen(s) < CORPUS_SIZE) sappend(s, line);
+	return s;
+}
+
+static void s_bench(const char* name, const char* corpus)
+{
+	int len = slen(corpus);
+	int* codepoints = (int*)cf_alloc(sizeof(int) * len);
+	double mb = (double)len * ITERATIONS / (1024.0 * 1024.0);
+	int checksum = 0;
+
+	CF_Stopwatch sw = cf_make_stopwatch();
+	for (int i = 0; i < ITERATIONS; ++i) {
+		const char* tmp = corpus;
+		int count = 0;
+		while (*tmp) {
+			tmp = cf_decode_UTF8(tmp, codepoints + count++);
+		}
+		checksum += codepoints[count - 1];
+	}
+	double scalar = cf_stopwatch_seconds(sw);
+
+	sw = cf_make_stopwatch();
+	for (int i = 0; i < ITERATIONS; ++i) {
+		int count = cf_decode_UTF8_bulk(corpus, len, codepoints);
+		checksum += codepoints[count - 1];
+	}
+	double bulk = cf_stopwatch_seconds(sw);
+
+	printf("%-6s UTF8 decode   : cf_decode_UTF8 %8.1f MB/s, cf_decode_UTF8_bulk %8.1f MB/s (%.2fx)\n", name, mb / scalar, mb / bulk, scalar / bulk);
+
+	// Build a UTF16 copy of the corpus for the transcoding test.
+	int count = cf_decode_UTF8_bulk(corpus, len, codepoints);
+	uint16_t* utf16 = (uint16_t*)cf_alloc(sizeof(uint16_t) * (count + 1));
+	for (int i = 0; i < count; ++i) utf16[i] = (uint16_t)codepoints[i];
+	utf16[count] = 0;
+
+	sw = cf_make_stopwatch();
+	for (int i = 0; i < ITERATIONS; ++i) {
+		char* s = NULL;
+		const uint16_t* tmp = utf16;
+		while (*tmp) {
+			int cp;
+			tmp = cf_decode_UTF16(tmp, &cp);
+			sappend_UTF8(s, cp);
+		}
+		checksum += slen(s);
+		sfree(s);
+	}
+	scalar = cf_stopwatch_seconds(sw);
+
+	sw = cf_make_stopwatch();
+	for (int i = 0; i < ITERATIONS; ++i) {
+		char* s = NULL;
+		sappend_UTF16(s, utf16, count);
+		checksum += slen(s);
+		sfree(s);
+	}
+	bulk = cf_stopwatch_seconds(sw);
+
+	printf("%-6s UTF16 -> UTF8 : per-codepoint  %8.1f MB/s, sappend_UTF16       %8.1f MB/s (%.2fx)\n", name, mb / scalar, mb / bulk, scalar / bulk);
+	printf("(checksum %d)\n", checksum);
+
+	cf_free(utf16);
+	cf_free(codepoints);
+}
+
+int main(int argc, char* argv[])
+{
+	char* latin = s_make_corpus(s_latin_line);
+	char* cjk = s_make_corpus(s_cjk_line);
+
+	s_bench("Latin", latin);
+	s_bench("CJK", cjk);
+
+	sfree(latin);
+	sfree(cjk);
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <cute.h>
+using namespace Cute;
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Replays a frame saved with `cf_draw_capture_begin`/`cf_draw_capture_end` and prints its draw stats and CPU time per
+// frame. Run it on captures from two versions of the framework to compare them. Uses the null graphics backend by
+// default, pass --gpu to replay on a real GPU instead.
+//
+// Usage: draw_replay <capture> [frames] [--gpu]
+// The capture path is relative to the folder containing this executable.
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		printf("Usage: draw_replay <capture> [frames] [--gpu]\n");
+		return -1;
+	}
+	const char* path = argv[1];
+	int frames = 100;
+	bool gpu = false;
+	for (int i = 2; i < argc; ++i) {
+		if (!CF_STRCMP(argv[i], "--gpu")) gpu = true;
+		else frames = atoi(argv[i]);
+	}
+	if (frames < 1) frames = 1;
+
+	int options = APP_OPTIONS_HIDDEN_BIT | APP_OPTIONS_NO_AUDIO_BIT;
+	if (!gpu) options |= APP_OPTIONS_GFX_NULL_BIT;
+	Result result = make_app("Draw Replay", 0, 0, 0, 640, 480, options, argv[0]);
+	if (is_error(result)) {
+		printf("%s\n", result.details);
+		return -1;
+	}
+
+	char capture[1024];
+	snprintf(capture, sizeof(capture), "/%s", path);
+	double seconds = 0;
+	DrawStats stats = { };
+	for (int i = 0; i < frames; ++i) {
+		app_update();
+		CF_Stopwatch sw = cf_make_stopwatch();
+		result = draw_replay_capture(capture, app_get_canvas());
+		app_draw_onto_screen();
+		seconds += cf_stopwatch_seconds(sw);
+		if (is_error(result)) {
+			printf("%s\n", result.details);
+			destroy_app();
+			return -1;
+		}
+		stats = draw_get_stats();
+	}
+
+	printf("{\n");
+	printf("  \"capture\": \"%s\",\n", path);
+	printf("  \"frames\": %d,\n", frames);
+	printf("  \"ms_per_frame\": %.4f,\n", seconds * 1000.0 / frames);
+	printf("  \"draw_calls\": %d,\n", stats.draw_call_count);
+	printf("  \"render_passes\": %d,\n", stats.render_pass_count);
+	printf("  \"batches\": %d,\n", stats.batch_count);
+	printf("  \"uploads\": %d,\n", stats.upload_count);
+	printf("  \"vertex_bytes\": %llu\n", (unsigned long long)stats.vertex_bytes);
+	printf("}\n");
+
+	destroy_app();
+	return 0;
+}
@@ -194,6 +194,7 @@ CF_Result cf_make_app(const char* window_title, CF_DisplayID display_id, int x,
 	bool use_dx12 = options & APP_OPTIONS_GFX_D3D12_BIT;
 	bool use_metal = options & APP_OPTIONS_GFX_METAL_BIT;
 	bool use_vulkan = options & APP_OPTIONS_GFX_VULKAN_BIT;
+	bool use_null = options & APP_OPTIONS_GFX_NULL_BIT;
 	bool use_gfx = !(options & APP_OPTIONS_NO_GFX_BIT);
 
 	// Ensure the user selected only one backend, if they selected one at all.
@@ -217,6 +218,16 @@ CF_Result cf_make_app(const char* window_title, CF_DisplayID display_id, int x,
 		CF_ASSERT(!use_dx12);
 		CF_ASSERT(!use_metal);
 	}
+	if (use_null) {
+		CF_ASSERT(use_gfx);
+		CF_ASSERT(!use_dx11);
+		CF_ASSERT(!use_dx12);
+		CF_ASSERT(!use_metal);
+		CF_ASSERT(!use_vulkan);
+
+		// No display is needed, the window only exists to keep the rest of the app running as usual.
+		SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+	}
 
 #ifdef CF_EMSCRIPTEN
 	Uint32 sdl_options = SDL_INIT_EVENTS | SDL_INIT_VIDEO | SDL_INIT_GAMEPAD;
@@ -238,7 +249,7 @@ CF_Result cf_make_app(const char* window_title, CF_DisplayID display_id, int x,
 	}
 
 	SDL_GPUDevice* device = NULL;
-	if (use_gfx) {
+	if (use_gfx && !use_null) {
 		// Some backends don't support window size of zero.
 		w = w <= 0 ? 1 : w;
 		h = h <= 0 ? 1 : h;
@@ -299,10 +310,13 @@ CF_Result cf_make_app(const char* window_title, CF_DisplayID display_id, int x,
 	cf_make_png_cache();
 
 	if (use_gfx) {
-		app->device = device;
-		SDL_ClaimWindowForGPUDevice(app->device, app->window);
-		cf_app_set_vsync_mailbox(app->vsync);
-		app->cmd = SDL_AcquireGPUCommandBuffer(app->device);
+		app->gfx_null = use_null;
+		if (!use_null) {
+			app->device = device;
+			SDL_ClaimWindowForGPUDevice(app->device, app->window);
+			cf_app_set_vsync_mailbox(app->vsync);
+			app->cmd = SDL_AcquireGPUCommandBuffer(app->device);
+		}
 		cf_load_internal_shaders();
 		cf_make_draw();
 		
@@ -332,7 +346,7 @@ CF_Result cf_make_app(const char* window_title, CF_DisplayID display_id, int x,
 
 		// Create the default font.
 		make_font_from_memory(calibri_data, calibri_sz, "Calibri");
-		SDL_SubmitGPUCommandBuffer(app->cmd);
+		if (app->cmd) SDL_SubmitGPUCommandBuffer(app->cmd);
 		app->cmd = NULL;
 	}
 
@@ -464,7 +478,7 @@ void cf_app_update(CF_OnUpdateFn* on_update)
 			ImGui::NewFrame();
 		}
 
-		app->cmd = SDL_AcquireGPUCommandBuffer(app->device);
+		if (!app->gfx_null) app->cmd = SDL_AcquireGPUCommandBuffer(app->device);
 		cf_shader_watch();
 	}
 	app->user_on_update = on_update;
@@ -517,7 +531,7 @@ int cf_app_draw_onto_screen(bool clear)
 
 	// Stretch the app canvas onto the backbuffer canvas.
 	Uint32 w, h;
-	SDL_GPUTexture* swapchain_tex = SDL_AcquireGPUSwapchainTexture(app->cmd, app->window, &w, &h);
+	SDL_GPUTexture* swapchain_tex = app->gfx_null ? NULL : SDL_AcquireGPUSwapchainTexture(app->cmd, app->window, &w, &h);
 	if (swapchain_tex) {
 		// Blit onto the screen.
 		SDL_GPUBlitRegion src = {
@@ -554,7 +568,7 @@ int cf_app_draw_onto_screen(bool clear)
 		draw->delay_defrag = false;
 	}
 
-	SDL_SubmitGPUCommandBuffer(app->cmd);
+	if (app->cmd) SDL_SubmitGPUCommandBuffer(app->cmd);
 	app->cmd = NULL;
 
 	// Clear all pushed draw parameters.
@@ -562,6 +576,7 @@ int cf_app_draw_onto_screen(bool clear)
 	draw->colors.set_count(1);
 	draw->antialias.set_count(1);
 	draw->antialias_scale.set_count(1);
+	draw->culling.set_count(1);
 	draw->render_states.set_count(1);
 	draw->scissors.set_count(1);
 	draw->viewports.set_count(1);
@@ -575,13 +590,24 @@ int cf_app_draw_onto_screen(bool clear)
 	draw->user_params.set_count(1);
 	draw->shaders.set_count(1);
 	draw->verts.clear();
+	draw->sprite_verts.clear();
 	draw->draw_item_order = 0;
 	draw->cmds.clear();
+	draw->items.clear();
 	draw->add_cmd();
+	cf_draw_evict_tessellations(false);
+
+	// Snapshot this frame's draw stats for `cf_draw_get_stats`.
+	draw->stats.draw_call_count = app->draw_call_count;
+	draw->stats.render_pass_count = app->render_pass_count;
+	draw->stats.bytes_per_sprite = draw->stats.sprite_count ? (float)((double)draw->stats.sprite_vertex_bytes / draw->stats.sprite_count) : 0;
+	draw->stats_prev = draw->stats;
+	draw->stats = { };
 
 	// Report the number of draw calls.
 	int draw_call_count = app->draw_call_count;
 	app->draw_call_count = 0;
+	app->render_pass_count = 0;
 	return draw_call_count;
 }
 
@@ -745,12 +771,14 @@ int cf_app_get_canvas_height()
 void cf_app_set_vsync(bool true_turn_on_vsync)
 {
 	app->vsync = true_turn_on_vsync;
+	if (!app->device) return;
 	SDL_SetGPUSwapchainParameters(app->device, app->window, SDL_GPU_SWAPCHAINCOMPOSITION_SDR, app->vsync ? SDL_GPU_PRESENTMODE_VSYNC : SDL_GPU_PRESENTMODE_IMMEDIATE);
 }
 
 void cf_app_set_vsync_mailbox(bool true_turn_on_mailbox)
 {
 	app->vsync = true_turn_on_mailbox;
+	if (!app->device) return;
 	SDL_SetGPUSwapchainParameters(app->device, app->window, SDL_GPU_SWAPCHAINCOMPOSITION_SDR, app->vsync ? SDL_GPU_PRESENTMODE_MAILBOX : SDL_GPU_PRESENTMODE_IMMEDIATE);
 }
 
@@ -800,7 +828,7 @@ void cf_app_set_icon(const char* virtual_path_to_png)
 
 ImGuiContext* cf_app_init_imgui()
 {
-	if (!app->gfx_enabled) return NULL;
+	if (!app->gfx_enabled || app->gfx_null) return NULL;
 	
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
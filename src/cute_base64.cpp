@@ -8,6 +8,10 @@
 #include <cute_base64.h>
 #include <cute_c_runtime.h>
 
+#include <internal/cute_simd_internal.h>
+
+#include <SDL3/SDL_cpuinfo.h>
+
 // Implementation referenced from: https://tools.ietf.org/html/rfc4648
 
 // From: https://tools.ietf.org/html/rfc4648#section-3.2
@@ -37,6 +41,225 @@ static const int s_base64_to_6bits[80] = {
 	26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,
 };
 
+//--------------------------------------------------------------------------------------------------
+// SIMD kernels.
+//
+// Each kernel only handles the bulk of the stream, whole blocks of full triplets (or quadruplets
+// without any `=` padding), and returns how many bytes of `in` it consumed. The scalar loops below
+// pick up from there to handle the tail, padding and error reporting. A decode kernel simply stops
+// at the first block containing an illegal character and leaves it for the scalar loop to report.
+//
+// The x64 kernels follow Wojciech Muła and Daniel Lemire's "Faster Base64 Encoding and Decoding
+// using AVX2 Instructions". The NEON kernels deinterleave with vld3/vld4 and work on 6-bit lanes.
+
+typedef size_t (cf_base64_encode_fn)(uint8_t* out, const uint8_t* in, size_t in_size);
+typedef size_t (cf_base64_decode_fn)(uint8_t* out, size_t out_size, const uint8_t* in, size_t in_size);
+
+#ifdef CF_SIMD_X86
+
+// Spreads each group of 3 bytes in the low 12 bytes of a lane across 4 bytes, ready to be split
+// into 6-bit values with the multiplies below.
+#define CF_BASE64_ENCODE_SPLIT 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+
+// Offsets to add to each 6-bit value to reach its ASCII character, indexed by a reduced value
+// computed in the encode kernels: 0 for 'a'-'z', 1-10 for '0'-'9', 11 for '+', 12 for '/' and
+// 13 for 'A'-'Z'.
+#define CF_BASE64_ENCODE_OFFSETS 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+
+// Valid characters have no bits in common between these two tables when looked up by their low
+// and high nibble respectively. The third table maps the high nibble (with '/' special-cased) to
+// the offset from ASCII back to the 6-bit value.
+#define CF_BASE64_DECODE_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define CF_BASE64_DECODE_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define CF_BASE64_DECODE_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+
+// Packs the four 6-bit values of each 32-bit lane back into 3 bytes at the front of each 128-bit lane.
+#define CF_BASE64_DECODE_PACK_SHUFFLE 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+CF_TARGET("ssse3") static size_t s_encode_ssse3(uint8_t* out, const uint8_t* in, size_t in_size)
+{
+	const __m128i split = _mm_setr_epi8(CF_BASE64_ENCODE_SPLIT);
+	const __m128i offsets = _mm_setr_epi8(CF_BASE64_ENCODE_OFFSETS);
+	size_t i = 0;
+	// Each block reads 16 bytes but only consumes 12 of them.
+	for (; in_size - i >= 16; i += 12, out += 16) {
+		__m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + i)), split);
+		__m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+		__m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+		__m128i indices = _mm_or_si128(t0, t1);
+		__m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		reduced = _mm_or_si128(reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+		__m128i chars = _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+		_mm_storeu_si128((__m128i*)out, chars);
+	}
+	return i;
+}
+
+CF_TARGET("ssse3") static size_t s_decode_ssse3(uint8_t* out, size_t out_size, const uint8_t* in, size_t in_size)
+{
+	const __m128i lut_lo = _mm_setr_epi8(CF_BASE64_DECODE_LO);
+	const __m128i lut_hi = _mm_setr_epi8(CF_BASE64_DECODE_HI);
+	const __m128i lut_roll = _mm_setr_epi8(CF_BASE64_DECODE_ROLL);
+	const __m128i pack = _mm_setr_epi8(CF_BASE64_DECODE_PACK_SHUFFLE);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	size_t i = 0;
+	// Each block writes 16 bytes but only produces 12 of them.
+	for (; in_size - i >= 16 && out_size >= 16; i += 16, out += 12, out_size -= 12) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+		__m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), mask);
+		__m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(v, mask));
+		__m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+		if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128()))) break;
+		__m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')), hi_nibbles));
+		__m128i values = _mm_add_epi8(v, roll);
+		__m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+		merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+		_mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(merged, pack));
+	}
+	return i;
+}
+
+CF_TARGET("avx2") static size_t s_encode_avx2(uint8_t* out, const uint8_t* in, size_t in_size)
+{
+	const __m256i split = _mm256_setr_epi8(CF_BASE64_ENCODE_SPLIT, CF_BASE64_ENCODE_SPLIT);
+	const __m256i offsets = _mm256_setr_epi8(CF_BASE64_ENCODE_OFFSETS, CF_BASE64_ENCODE_OFFSETS);
+	size_t i = 0;
+	// Each block loads 12 bytes into each 128-bit lane, reading 28 bytes but only consuming 24.
+	for (; in_size - i >= 28; i += 24, out += 32) {
+		__m128i lo = _mm_loadu_si128((const __m128i*)(in + i));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(in + i + 12));
+		__m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), split);
+		__m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+		__m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+		__m256i indices = _mm256_or_si256(t0, t1);
+		__m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+		reduced = _mm256_or_si256(reduced, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+		__m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, reduced), indices);
+		_mm256_storeu_si256((__m256i*)out, chars);
+	}
+	return i + s_encode_ssse3(out, in + i, in_size - i);
+}
+
+CF_TARGET("avx2") static size_t s_decode_avx2(uint8_t* out, size_t out_size, const uint8_t* in, size_t in_size)
+{
+	const __m256i lut_lo = _mm256_setr_epi8(CF_BASE64_DECODE_LO, CF_BASE64_DECODE_LO);
+	const __m256i lut_hi = _mm256_setr_epi8(CF_BASE64_DECODE_HI, CF_BASE64_DECODE_HI);
+	const __m256i lut_roll = _mm256_setr_epi8(CF_BASE64_DECODE_ROLL, CF_BASE64_DECODE_ROLL);
+	const __m256i pack = _mm256_setr_epi8(CF_BASE64_DECODE_PACK_SHUFFLE, CF_BASE64_DECODE_PACK_SHUFFLE);
+	const __m256i gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+	const __m256i mask = _mm256_set1_epi8(0x0F);
+	size_t i = 0;
+	// Each block writes 32 bytes but only produces 24 of them.
+	for (; in_size - i >= 32 && out_size >= 32; i += 32, out += 24, out_size -= 24) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+		__m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask);
+		__m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(v, mask));
+		__m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+		if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256()))) break;
+		__m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')), hi_nibbles));
+		__m256i values = _mm256_add_epi8(v, roll);
+		__m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+		merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+		merged = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, pack), gather);
+		_mm256_storeu_si256((__m256i*)out, merged);
+	}
+	return i + s_decode_ssse3(out, out_size, in + i, in_size - i);
+}
+
+#elif defined(CF_SIMD_NEON)
+
+static size_t s_encode_neon(uint8_t* out, const uint8_t* in, size_t in_size)
+{
+	uint8x16x4_t table;
+	for (int j = 0; j < 4; ++j) table.val[j] = vld1q_u8(s_6bits_to_base64 + j * 16);
+	const uint8x16_t mask = vdupq_n_u8(0x3F);
+	size_t i = 0;
+	for (; in_size - i >= 48; i += 48, out += 64) {
+		uint8x16x3_t v = vld3q_u8(in + i);
+		uint8x16x4_t chars;
+		chars.val[0] = vshrq_n_u8(v.val[0], 2);
+		chars.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[0], 4), vshrq_n_u8(v.val[1], 4)), mask);
+		chars.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[1], 2), vshrq_n_u8(v.val[2], 6)), mask);
+		chars.val[3] = vandq_u8(v.val[2], mask);
+		for (int j = 0; j < 4; ++j) chars.val[j] = vqtbl4q_u8(table, chars.val[j]);
+		vst4q_u8(out, chars);
+	}
+	return i;
+}
+
+// Converts 16 characters to their 6-bit values, or sets `bad` if any of them are illegal. Same
+// nibble lookup technique as the x64 kernels.
+static CF_INLINE uint8x16_t s_decode_neon_lanes(uint8x16_t v, uint8x16_t* bad)
+{
+	static const uint8_t lut_lo[16] = { 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A };
+	static const uint8_t lut_hi[16] = { 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 };
+	static const int8_t lut_roll[16] = { 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint8x16_t hi_nibbles = vshrq_n_u8(v, 4);
+	uint8x16_t lo = vqtbl1q_u8(vld1q_u8(lut_lo), vandq_u8(v, vdupq_n_u8(0x0F)));
+	uint8x16_t hi = vqtbl1q_u8(vld1q_u8(lut_hi), hi_nibbles);
+	*bad = vorrq_u8(*bad, vandq_u8(lo, hi));
+	uint8x16_t roll = vqtbl1q_u8(vreinterpretq_u8_s8(vld1q_s8(lut_roll)), vaddq_u8(vceqq_u8(v, vdupq_n_u8('/')), hi_nibbles));
+	return vaddq_u8(v, roll);
+}
+
+static size_t s_decode_neon(uint8_t* out, size_t out_size, const uint8_t* in, size_t in_size)
+{
+	size_t i = 0;
+	for (; in_size - i >= 64 && out_size >= 48; i += 64, out += 48, out_size -= 48) {
+		uint8x16x4_t v = vld4q_u8(in + i);
+		uint8x16_t bad = vdupq_n_u8(0);
+		uint8x16_t a = s_decode_neon_lanes(v.val[0], &bad);
+		uint8x16_t b = s_decode_neon_lanes(v.val[1], &bad);
+		uint8x16_t c = s_decode_neon_lanes(v.val[2], &bad);
+		uint8x16_t d = s_decode_neon_lanes(v.val[3], &bad);
+		if (vmaxvq_u8(bad)) break;
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+		vst3q_u8(out, bytes);
+	}
+	return i;
+}
+
+#endif
+
+struct CF_Base64Kernels
+{
+	cf_base64_encode_fn* encode; // NULL when there's no SIMD kernel, leaving everything to the scalar loops.
+	cf_base64_decode_fn* decode;
+};
+
+// Picks the widest kernels the CPU supports.
+static CF_Base64Kernels s_pick_kernels()
+{
+	CF_Base64Kernels kernels = { NULL, NULL };
+#if defined(CF_SIMD_X86)
+	// SDL has no query for SSSE3 by itself, but every CPU with SSE4.1 has SSSE3.
+	if (SDL_HasAVX2()) {
+		kernels.encode = s_encode_avx2;
+		kernels.decode = s_decode_avx2;
+	} else if (SDL_HasSSE41()) {
+		kernels.encode = s_encode_ssse3;
+		kernels.decode = s_decode_ssse3;
+	}
+#elif defined(CF_SIMD_NEON)
+	kernels.encode = s_encode_neon;
+	kernels.decode = s_decode_neon;
+#endif
+	return kernels;
+}
+
+// The kernels are picked once, on first use. Initialization of a function-local static is
+// thread-safe, so both pointers are always seen together.
+static const CF_Base64Kernels& s_kernels()
+{
+	static const CF_Base64Kernels kernels = s_pick_kernels();
+	return kernels;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 CF_Result cf_base64_encode(void* dst, size_t dst_size, const void* src, size_t src_size)
 {
 	size_t out_size = CF_BASE64_ENCODED_SIZE(src_size);
@@ -48,6 +271,12 @@ CF_Result cf_base64_encode(void* dst, size_t dst_size, const void* src, size_t s
 	const uint8_t* in = (const uint8_t*)src;
 	uint8_t* out = (uint8_t*)dst;
 
+	cf_base64_encode_fn* kernel = s_kernels().encode;
+	size_t consumed = kernel ? kernel(out, in, src_size) : 0;
+	in += consumed;
+	out += consumed / 3 * 4;
+	triplets -= consumed / 3;
+
 	while (triplets--)
 	{
 		uint32_t bits = ((uint32_t)in[0]) << 16 | ((uint32_t)in[1]) << 8 | ((uint32_t)in[2]);
@@ -120,17 +349,19 @@ CF_Result cf_base64_decode(void* dst, size_t dst_size, const void* src, size_t s
 	if (end[-2] == '=') pads++;
 	if (pads) quadruplets--;
 
-	size_t exact_out_size = CF_BASE64_DECODED_SIZE(src_size);
-	switch (pads)
-	{
-	case 1: dst_size -= 2; break;
-	case 2: dst_size -= 1; break;
-	}
-	if (CF_BASE64_DECODED_SIZE(src_size) < exact_out_size) return cf_result_error("'dst_size' is too small to decode.");
+	size_t exact_out_size = CF_BASE64_DECODED_SIZE(src_size) - pads;
+	if (dst_size < exact_out_size) return cf_result_error("'dst_size' is too small to decode.");
 
 	// RFC describes the best way to handle bad input is to reject the entire input.
 	// https://tools.ietf.org/html/rfc4648#page-14
 
+	// Kernels may write past the bytes they produce, but never past `dst_size`.
+	cf_base64_decode_fn* kernel = s_kernels().decode;
+	size_t consumed = kernel ? kernel(out, dst_size, in, quadruplets * 4) : 0;
+	in += consumed;
+	out += consumed / 4 * 3;
+	quadruplets -= consumed / 4;
+
 	while (quadruplets--)
 	{
 		uint32_t a = *in++ - 43;
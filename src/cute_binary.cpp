@@ -0,0 +1,213 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#include <cute_binary.h>
+#include <cute_alloc.h>
+#include <cute_array.h>
+#include <cute_hashtable.h>
+#include <cute_c_runtime.h>
+
+#include <internal/cute_serialize_internal.h>
+
+using namespace Cute;
+
+#define CF_BINARY_MAGIC           ((uint32_t)'C' | ((uint32_t)'F' << 8) | ((uint32_t)'B' << 16) | ((uint32_t)'N' << 24))
+#define CF_BINARY_HEADER_SIZE     32
+#define CF_BINARY_SECTION_SIZE    24
+#define CF_BINARY_ALIGN(x)        (((x) + (CF_BINARY_ALIGNMENT - 1)) & ~(uint64_t)(CF_BINARY_ALIGNMENT - 1))
+
+struct CF_BinarySection
+{
+	uint32_t name;
+	uint64_t offset; // Into `CF_BinaryWriterInternal::data`.
+	uint64_t size;
+};
+
+struct CF_BinaryWriterInternal
+{
+	Array<char> strings;
+	Map<uint64_t, uint32_t> string_offsets;
+	Array<CF_BinarySection> sections;
+	Array<uint8_t> data;
+};
+
+static uint64_t s_hash_string(const char* s)
+{
+	uint64_t h = 14695981039346656037ULL;
+	while (*s) {
+		h ^= (uint8_t)*s++;
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+CF_BinaryWriter cf_make_binary_writer()
+{
+	CF_BinaryWriterInternal* w = CF_NEW(CF_BinaryWriterInternal);
+	// Offset 0 is reserved for the empty string.
+	w->strings.add(0);
+	CF_BinaryWriter result = { (uint64_t)w };
+	return result;
+}
+
+void cf_destroy_binary_writer(CF_BinaryWriter w_handle)
+{
+	CF_BinaryWriterInternal* w = (CF_BinaryWriterInternal*)w_handle.id;
+	w->~CF_BinaryWriterInternal();
+	cf_free(w);
+}
+
+uint32_t cf_binary_writer_add_string(CF_BinaryWriter w_handle, const char* string)
+{
+	CF_BinaryWriterInternal* w = (CF_BinaryWriterInternal*)w_handle.id;
+	if (!string || !*string) return 0;
+
+	// Look for an identical string already in the table. On a hash collision the string is simply
+	// stored a second time, which is wasteful but still correct.
+	uint64_t h = s_hash_string(string);
+	uint32_t* existing = w->string_offsets.try_get(h);
+	if (existing && !CF_STRCMP(w->strings.data() + *existing, string)) {
+		return *existing;
+	}
+
+	uint32_t offset = (uint32_t)w->strings.count();
+	int len = (int)CF_STRLEN(string) + 1;
+	w->strings.ensure_count(offset + len);
+	CF_MEMCPY(w->strings.data() + offset, string, len);
+	if (!existing) w->string_offsets.add(h, offset);
+	return offset;
+}
+
+void cf_binary_writer_add_section(CF_BinaryWriter w_handle, const char* name, const void* data, size_t size)
+{
+	CF_BinaryWriterInternal* w = (CF_BinaryWriterInternal*)w_handle.id;
+	CF_BinarySection section;
+	section.name = cf_binary_writer_add_string(w_handle, name);
+	section.offset = CF_BINARY_ALIGN((uint64_t)w->data.count());
+	section.size = (uint64_t)size;
+	w->data.ensure_count((int)(section.offset + size));
+	if (size) CF_MEMCPY(w->data.data() + section.offset, data, size);
+	w->sections.add(section);
+}
+
+void* cf_binary_writer_finish(CF_BinaryWriter w_handle, size_t* size_out)
+{
+	CF_BinaryWriterInternal* w = (CF_BinaryWriterInternal*)w_handle.id;
+
+	uint32_t section_table_offset = CF_BINARY_HEADER_SIZE;
+	uint32_t string_table_offset = section_table_offset + CF_BINARY_SECTION_SIZE * w->sections.count();
+	uint32_t string_table_size = (uint32_t)w->strings.count();
+	uint64_t data_offset = CF_BINARY_ALIGN((uint64_t)string_table_offset + string_table_size);
+	uint64_t total_size = data_offset + (uint64_t)w->data.count();
+
+	uint8_t* buffer = (uint8_t*)cf_alloc((size_t)total_size);
+	CF_MEMSET(buffer, 0, (size_t)total_size);
+
+	uint8_t* p = buffer;
+	cf_write_uint32(&p, CF_BINARY_MAGIC);
+	cf_write_uint16(&p, CF_BINARY_VERSION);
+	cf_write_uint16(&p, 0);
+	cf_write_uint32(&p, (uint32_t)w->sections.count());
+	cf_write_uint32(&p, section_table_offset);
+	cf_write_uint32(&p, string_table_offset);
+	cf_write_uint32(&p, string_table_size);
+	cf_write_uint64(&p, total_size);
+	CF_ASSERT(p == buffer + CF_BINARY_HEADER_SIZE);
+
+	for (int i = 0; i < w->sections.count(); ++i) {
+		CF_BinarySection section = w->sections[i];
+		cf_write_uint32(&p, section.name);
+		cf_write_uint32(&p, 0);
+		cf_write_uint64(&p, data_offset + section.offset);
+		cf_write_uint64(&p, section.size);
+	}
+
+	CF_MEMCPY(buffer + string_table_offset, w->strings.data(), string_table_size);
+	if (w->data.count()) CF_MEMCPY(buffer + data_offset, w->data.data(), w->data.count());
+
+	if (size_out) *size_out = (size_t)total_size;
+	return buffer;
+}
+
+CF_Result cf_binary_reader_init(CF_BinaryReader* r, const void* data, size_t size)
+{
+	CF_MEMSET(r, 0, sizeof(*r));
+	if (!data || size < CF_BINARY_HEADER_SIZE) return cf_result_error("Binary container is too small to contain a header.");
+
+	uint8_t* p = (uint8_t*)data;
+	uint32_t magic = cf_read_uint32(&p);
+	uint16_t version = cf_read_uint16(&p);
+	cf_read_uint16(&p);
+	uint32_t section_count = cf_read_uint32(&p);
+	uint32_t section_table_offset = cf_read_uint32(&p);
+	uint32_t string_table_offset = cf_read_uint32(&p);
+	uint32_t string_table_size = cf_read_uint32(&p);
+	uint64_t total_size = cf_read_uint64(&p);
+
+	if (magic != CF_BINARY_MAGIC) return cf_result_error("Not a binary container (bad magic number).");
+	if (version != CF_BINARY_VERSION) return cf_result_error("Unsupported binary container version.");
+	if (total_size > (uint64_t)size) return cf_result_error("Binary container is truncated.");
+	if ((uint64_t)section_table_offset + (uint64_t)section_count * CF_BINARY_SECTION_SIZE > total_size) return cf_result_error("Binary container section table is out of bounds.");
+	if ((uint64_t)string_table_offset + string_table_size > total_size) return cf_result_error("Binary container string table is out of bounds.");
+	if (!string_table_size || ((const char*)data)[string_table_offset + string_table_size - 1] != 0) return cf_result_error("Binary container string table is not nul-terminated.");
+
+	const uint8_t* sections = (const uint8_t*)data + section_table_offset;
+	for (uint32_t i = 0; i < section_count; ++i) {
+		p = (uint8_t*)sections + i * CF_BINARY_SECTION_SIZE;
+		uint32_t name = cf_read_uint32(&p);
+		cf_read_uint32(&p);
+		uint64_t offset = cf_read_uint64(&p);
+		uint64_t section_size = cf_read_uint64(&p);
+		if (name >= string_table_size) return cf_result_error("Binary container section name is out of bounds.");
+		if (offset > total_size || section_size > total_size - offset) return cf_result_error("Binary container section is out of bounds.");
+	}
+
+	r->data = (const uint8_t*)data;
+	r->size = (size_t)total_size;
+	r->section_count = (int)section_count;
+	r->sections = sections;
+	r->strings = (const char*)data + string_table_offset;
+	r->strings_size = string_table_size;
+	return cf_result_success();
+}
+
+int cf_binary_section_count(const CF_BinaryReader* r)
+{
+	return r->section_count;
+}
+
+const void* cf_binary_section_at(const CF_BinaryReader* r, int index, const char** name, size_t* size)
+{
+	CF_ASSERT(index >= 0 && index < r->section_count);
+	uint8_t* p = (uint8_t*)r->sections + index * CF_BINARY_SECTION_SIZE;
+	uint32_t name_offset = cf_read_uint32(&p);
+	cf_read_uint32(&p);
+	uint64_t offset = cf_read_uint64(&p);
+	uint64_t section_size = cf_read_uint64(&p);
+	if (name) *name = r->strings + name_offset;
+	if (size) *size = (size_t)section_size;
+	return r->data + offset;
+}
+
+const void* cf_binary_section(const CF_BinaryReader* r, const char* name, size_t* size)
+{
+	for (int i = 0; i < r->section_count; ++i) {
+		const char* section_name;
+		const void* section = cf_binary_section_at(r, i, &section_name, size);
+		if (!CF_STRCMP(section_name, name)) {
+			return section;
+		}
+	}
+	if (size) *size = 0;
+	return NULL;
+}
+
+const char* cf_binary_string(const CF_BinaryReader* r, uint32_t offset)
+{
+	if (offset >= r->strings_size) return "";
+	return r->strings + offset;
+}
@@ -19,6 +19,7 @@
 #include <internal/cute_aseprite_cache_internal.h>
 #include <internal/cute_font_internal.h>
 #include <internal/cute_graphics_internal.h>
+#include <internal/cute_simd_internal.h>
 
 struct CF_Draw* draw;
 
@@ -98,8 +99,8 @@ void cf_get_pixels(SPRITEBATCH_U64 image_id, void* buffer, int bytes_to_fill, vo
 		} else {
 			CF_MEMSET(buffer, 0, bytes_to_fill);
 		}
-	} else if (image_id >= CF_PREMADE_ID_RANGE_LO && image_id <= CF_PREMADE_ID_RANGE_HI) {
-		// These are handled externally by the user, so spritebatch should never ask for pixels.
+	} else if (image_id >= CF_PREMADE_ID_RANGE_LO && image_id <= CF_CANVAS_ID_RANGE_HI) {
+		// These are handled externally by the user (or are canvases), so spritebatch should never ask for pixels.
 		// It's assumed premade atlases are generated properly externally.
 		CF_ASSERT(!"This should never be hit -- Invalid image_id sent to spritebatch.");
 		CF_MEMSET(buffer, 0, sizeof(bytes_to_fill));
@@ -116,41 +117,302 @@ static CF_INLINE float s_intersect(float a, float b, float u0, float u1, float p
 	return u0 + (u1 - u0) * (da / (da - db));
 }
 
-static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_w, int texture_h, void* udata)
+// Records a draw call for the current command. It's issued later by `cf_render_to`, once the vertices of
+// every batch have been uploaded.
+static void s_push_batch(CF_Shader shader, CF_Mesh mesh, int first_vertex, int vertex_count, int first_instance, int instance_count, int index_count, uint64_t texture_id, int texture_w, int texture_h)
+{
+	CF_DrawBatch batch = { };
+	batch.cmd_index = draw->cmd_index;
+	batch.shader = shader;
+	batch.mesh = mesh;
+	batch.first_vertex = first_vertex;
+	batch.vertex_count = vertex_count;
+	batch.first_instance = first_instance;
+	batch.instance_count = instance_count;
+	batch.index_count = index_count;
+	batch.texture_id = texture_id;
+	batch.texture_w = texture_w;
+	batch.texture_h = texture_h;
+	draw->batches.add(batch);
+	draw->has_drawn_something = true;
+}
+
+// Kicks off a draw call for a recorded batch with the state of its command.
+static void s_draw_batch(const CF_DrawBatch& batch, const CF_Command& cmd)
 {
-	CF_UNUSED(udata);
+	cf_mesh_set_draw_range(batch.mesh, batch.first_vertex, batch.vertex_count, batch.first_instance, batch.instance_count);
+	if (batch.index_count) cf_mesh_set_index_count(batch.mesh, batch.index_count);
+	cf_apply_mesh(batch.mesh);
+	draw->stats.batch_count++;
+
+	// Apply the atlas texture.
+	CF_Texture atlas = { batch.texture_id };
+	cf_material_set_texture_fs(draw->material, "u_image", atlas);
+
+	// Apply uniforms.
+	v2 u_texture_size = cf_v2((float)batch.texture_w, (float)batch.texture_h);
+	cf_material_set_uniform_fs(draw->material, "u_texture_size", &u_texture_size, CF_UNIFORM_TYPE_FLOAT2, 1);
+	v2 u_texel_size = cf_v2(1.0f / (float)batch.texture_w, 1.0f / (float)batch.texture_h);
+	cf_material_set_uniform_fs(draw->material, "u_texel_size", &u_texel_size, CF_UNIFORM_TYPE_FLOAT2, 1);
+	float alpha_discard = cmd.alpha_discard;
+	cf_material_set_uniform_fs(draw->material, "u_alpha_discard", &alpha_discard, CF_UNIFORM_TYPE_FLOAT, 1);
+
+	// Apply render state.
+	cf_material_set_render_state(draw->material, cmd.render_state);
+
+	// Kick off a draw call.
+	cf_apply_shader(batch.shader, draw->material);
+
+	// Apply viewport.
+	Rect viewport = cmd.viewport;
+	if (viewport.w >= 0 && viewport.h >= 0) {
+		cf_apply_viewport(viewport.x, viewport.y, viewport.w, viewport.h);
+	}
+
+	// Apply scissor, unless it's already baked into the vertices.
+	Rect scissor = cmd.scissor;
+	if (!draw->vertex_scissor && scissor.w >= 0 && scissor.h >= 0) {
+		cf_apply_scissor(scissor.x, scissor.y, scissor.w, scissor.h);
+	}
+
+	cf_draw_elements();
+}
+
+// Quads are sent as four vertices winding 0 -> 1 -> 2 -> 3, split into two triangles by this pattern.
+static const int s_quad_pattern[6] = { 0, 3, 1, 1, 3, 2 };
+
+// Makes sure the static quad index buffer shared by `quad_mesh` and `sprite_mesh` covers at least
+// `quad_count` quads. It only ever grows, so once warmed up this is a no-op. 16-bit indices are used
+// until there are too many vertices to address with them.
+static void s_ensure_quad_indices(int quad_count)
+{
+	if (quad_count <= draw->quad_index_capacity) return;
+	int capacity = cf_max(quad_count, draw->quad_index_capacity * 2);
+	int bits = capacity * 4 > 0xFFFF + 1 ? 32 : 16;
+	int index_count = capacity * 6;
+	void* indices = cf_alloc(index_count * (bits / 8));
+	for (int i = 0; i < capacity; ++i) {
+		for (int j = 0; j < 6; ++j) {
+			uint32_t index = (uint32_t)(i * 4 + s_quad_pattern[j]);
+			if (bits == 16) ((uint16_t*)indices)[i * 6 + j] = (uint16_t)index;
+			else ((uint32_t*)indices)[i * 6 + j] = index;
+		}
+	}
+	CF_Mesh meshes[] = { draw->quad_mesh, draw->sprite_mesh };
+	for (int i = 0; i < CF_ARRAY_SIZE(meshes); ++i) {
+		if (bits != draw->quad_index_bits) {
+			cf_mesh_set_index_buffer(meshes[i], index_count * (bits / 8), bits);
+		}
+		cf_mesh_update_index_data(meshes[i], indices, index_count);
+	}
+	cf_free(indices);
+	draw->quad_index_capacity = capacity;
+	draw->quad_index_bits = bits;
+}
+
+// Generates the output of a range of items into `out`, returning how many of them were sprites. Must only
+// touch `out`, so ranges can be filled in parallel by `s_parallel_fill`.
+typedef int (CF_DrawFillFn)(const spritebatch_sprite_t* sprites, int count, void* out);
+
+struct CF_DrawFillTask
+{
+	CF_DrawFillFn* fn;
+	const spritebatch_sprite_t* sprites;
+	int count;
+	void* out;
+	int sprite_count;
+};
+
+static void s_fill_task(void* param)
+{
+	CF_DrawFillTask* task = (CF_DrawFillTask*)param;
+	task->sprite_count = task->fn(task->sprites, task->count, task->out);
+}
+
+#define CF_DRAW_MIN_ITEMS_PER_TASK 1024
+#define CF_DRAW_MAX_FILL_TASKS     64
+
+// Runs `fn` over a batch, split into contiguous ranges across the app's threadpool once the batch reaches
+// `draw->parallel_threshold` items. Each range writes its own slice of `out` (`stride` bytes per item), so
+// the output is identical to filling the whole batch on one thread.
+static int s_parallel_fill(CF_DrawFillFn* fn, const spritebatch_sprite_t* sprites, int count, void* out, int stride)
+{
+	int task_count = 1;
+	if (app->threadpool && draw->parallel_threshold > 0 && count >= draw->parallel_threshold) {
+		task_count = cf_min(cf_min(cf_core_count(), count / CF_DRAW_MIN_ITEMS_PER_TASK), CF_DRAW_MAX_FILL_TASKS);
+	}
+	if (task_count < 2) {
+		return fn(sprites, count, out);
+	}
+
+	CF_DrawFillTask tasks[CF_DRAW_MAX_FILL_TASKS];
+	int per_task = (count + task_count - 1) / task_count;
+	for (int i = 0; i < task_count; ++i) {
+		int begin = i * per_task;
+		CF_DrawFillTask* task = tasks + i;
+		task->fn = fn;
+		task->sprites = sprites + begin;
+		task->count = cf_max(0, cf_min(per_task, count - begin));
+		task->out = (char*)out + (size_t)begin * stride;
+		task->sprite_count = 0;
+		cf_threadpool_add_task(app->threadpool, s_fill_task, task);
+	}
+	cf_threadpool_kick_and_wait(app->threadpool);
+
+	int sprite_count = 0;
+	for (int i = 0; i < task_count; ++i) {
+		sprite_count += tasks[i].sprite_count;
+	}
+	return sprite_count;
+}
+
+// Writes four compact `CF_SpriteVertex`s per sprite/text item.
+static int s_write_sprite_verts(const spritebatch_sprite_t* sprites, int count, void* out_verts)
+{
+	CF_SpriteVertex* verts = (CF_SpriteVertex*)out_verts;
+	for (int i = 0; i < count; ++i) {
+		const spritebatch_sprite_t* s = sprites + i;
+		CF_SpriteVertex* out = verts + i * 4;
+		CF_ASSERT(s->geom.is_sprite || s->geom.is_text);
+
+		for (int j = 0; j < 4; ++j) {
+			out[j].posH = s->geom.shape[j];
+			out[j].color = s->geom.color;
+			out[j].type = s->geom.is_sprite ? VA_TYPE_SPRITE : VA_TYPE_TEXT;
+			out[j].alpha = (uint8_t)(s->geom.alpha * 255.0f);
+			out[j].fill = 0;
+			out[j].unused = 0;
+			out[j].attributes = s->geom.user_params;
+			CF_MEMCPY(out[j].clip, s->geom.clip, sizeof(out[j].clip));
+		}
+
+		out[0].uv = cf_v2(s->minx, s->maxy);
+		out[1].uv = cf_v2(s->maxx, s->maxy);
+		out[2].uv = cf_v2(s->maxx, s->miny);
+		out[3].uv = cf_v2(s->minx, s->miny);
+	}
+	return count;
+}
+
+// Appends compact `CF_SpriteVertex`s for a batch made up entirely of sprites/text, four per sprite.
+// Returns the index of the first vertex.
+static int s_fill_sprite_verts(spritebatch_sprite_t* sprites, int count)
+{
+	int first = draw->sprite_verts.count();
+	draw->sprite_verts.ensure_count(first + count * 4);
+	s_parallel_fill(s_write_sprite_verts, sprites, count, draw->sprite_verts.data() + first, (int)sizeof(CF_SpriteVertex) * 4);
+	return first;
+}
+
+// Expands four-vertex quads back out into a plain triangle list for the vertex callback, appended onto
+// `tri_verts`. Triangles and segments only produce their single (non-degenerate) triangle.
+static int s_expand_quads(spritebatch_sprite_t* sprites, int count, const CF_Vertex* quads)
+{
+	int first = draw->tri_verts.count();
+	draw->tri_verts.ensure_count(first + count * 6);
+	CF_Vertex* out = draw->tri_verts.data() + first;
 	int vert_count = 0;
-	draw->verts.ensure_count(count * 6);
-	CF_Vertex* verts = draw->verts.data();
-	CF_MEMSET(verts, 0, sizeof(CF_Vertex) * count * 6);
+	for (int i = 0; i < count; ++i) {
+		BatchGeometryType type = sprites[i].geom.type;
+		int n = (type == BATCH_GEOMETRY_TYPE_TRI || type == BATCH_GEOMETRY_TYPE_SEGMENT) ? 3 : 6;
+		for (int j = 0; j < n; ++j) {
+			out[vert_count++] = quads[i * 4 + s_quad_pattern[j]];
+		}
+	}
+	draw->tri_verts.set_count(first + vert_count);
+	return vert_count;
+}
+
+// Writes one `CF_DrawInstance` per shape/sprite. Every item must fit on a quad, i.e. anything except
+// `BATCH_GEOMETRY_TYPE_TRI` and `BATCH_GEOMETRY_TYPE_SEGMENT`.
+static int s_write_instances(const spritebatch_sprite_t* sprites, int count, void* out_instances)
+{
+	CF_DrawInstance* instances = (CF_DrawInstance*)out_instances;
+	CF_MEMSET(instances, 0, sizeof(CF_DrawInstance) * count);
+	int sprite_count = 0;
+
+	for (int i = 0; i < count; ++i) {
+		const spritebatch_sprite_t* s = sprites + i;
+		const BatchGeometry& geom = s->geom;
+		CF_DrawInstance* out = instances + i;
+		out->color = geom.color;
+		out->alpha = (uint8_t)(geom.alpha * 255.0f);
+		out->attributes = geom.user_params;
+		CF_MEMCPY(out->clip, geom.clip, sizeof(out->clip));
+
+		if (geom.type == BATCH_GEOMETRY_TYPE_SPRITE) {
+			CF_ASSERT(geom.is_sprite || geom.is_text);
+			for (int j = 0; j < 4; ++j) {
+				out->posH[j] = geom.shape[j];
+			}
+			out->uv_min = cf_v2(s->minx, s->miny);
+			out->uv_max = cf_v2(s->maxx, s->maxy);
+			out->type = geom.is_sprite ? VA_TYPE_SPRITE : VA_TYPE_TEXT;
+			sprite_count++;
+			continue;
+		}
+
+		for (int j = 0; j < 4; ++j) {
+			out->p[j] = geom.box[j];
+			out->posH[j] = geom.boxH[j];
+		}
+		out->radius = geom.radius;
+		out->aa = geom.aa;
+
+		if (geom.type == BATCH_GEOMETRY_TYPE_POLYGON) {
+			out->n = geom.n;
+			for (int j = 0; j < geom.n; ++j) {
+				out->shape[j] = geom.shape[j];
+			}
+			out->type = VA_TYPE_POLYGON;
+			out->fill = 255;
+			continue;
+		}
+
+		out->shape[0] = geom.shape[0];
+		out->shape[1] = geom.shape[1];
+		out->shape[2] = geom.shape[2];
+		out->stroke = geom.stroke;
+		out->fill = geom.fill ? 255 : 0;
+		switch (geom.type) {
+		case BATCH_GEOMETRY_TYPE_TRI_SDF: out->type = VA_TYPE_TRIANGLE_SDF; break;
+		case BATCH_GEOMETRY_TYPE_QUAD:    out->type = VA_TYPE_BOX; break;
+		case BATCH_GEOMETRY_TYPE_CIRCLE:  // Use the capsule path for circle rendering.
+		case BATCH_GEOMETRY_TYPE_CAPSULE: out->type = VA_TYPE_SEGMENT; break;
+		default: CF_ASSERT(!"Geometry type can not be instanced.");
+		}
+	}
+	return sprite_count;
+}
+
+// Appends one `CF_DrawInstance` per shape/sprite and returns the index of the first.
+static int s_fill_instances(spritebatch_sprite_t* sprites, int count)
+{
+	int first = draw->instances.count();
+	draw->instances.ensure_count(first + count);
+	int sprite_count = s_parallel_fill(s_write_instances, sprites, count, draw->instances.data() + first, (int)sizeof(CF_DrawInstance));
+	draw->stats.sprite_count += sprite_count;
+	draw->stats.sprite_vertex_bytes += (uint64_t)sprite_count * sizeof(CF_DrawInstance);
+	return first;
+}
+
+// Writes four full `CF_Vertex`s per item. Triangles and segments only need three vertices, so they're laid out
+// such that the quad pattern produces their triangle followed by a degenerate one.
+static int s_write_verts(const spritebatch_sprite_t* sprites, int count, void* out_verts)
+{
+	CF_Vertex* verts = (CF_Vertex*)out_verts;
+	CF_MEMSET(verts, 0, sizeof(CF_Vertex) * count * 4);
+	int sprite_count = 0;
 
 	for (int i = 0; i < count; ++i) {
-		spritebatch_sprite_t* s = sprites + i;
-		BatchGeometry geom = s->geom;
-		CF_Vertex* out = verts + vert_count;
-
-		v2 quad[6] = {
-			geom.box[0],
-			geom.box[3],
-			geom.box[1],
-			geom.box[1],
-			geom.box[3],
-			geom.box[2],
-		};
-
-		v2 quadH[6] = {
-			geom.boxH[0],
-			geom.boxH[3],
-			geom.boxH[1],
-			geom.boxH[1],
-			geom.boxH[3],
-			geom.boxH[2],
-		};
+		const spritebatch_sprite_t* s = sprites + i;
+		const BatchGeometry& geom = s->geom;
+		CF_Vertex* out = verts + i * 4;
 
 		switch (geom.type) {
 		case BATCH_GEOMETRY_TYPE_TRI:
 		{
-			for (int i = 0; i < 3; ++i) {
+			for (int i = 0; i < 4; ++i) {
 				out[i].color = s->geom.color;
 				out[i].radius = 0;
 				out[i].stroke = 0;
@@ -162,17 +424,16 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 			}
 
 			out[0].posH = geom.shape[0];
-			out[1].posH = geom.shape[1];
+			out[3].posH = geom.shape[1];
+			out[1].posH = geom.shape[2];
 			out[2].posH = geom.shape[2];
-		
-			vert_count += 3;
 		}	break;
 
 		case BATCH_GEOMETRY_TYPE_TRI_SDF:
 		{
-			for (int i = 0; i < 6; ++i) {
-				out[i].p = quad[i];
-				out[i].posH = quadH[i];
+			for (int i = 0; i < 4; ++i) {
+				out[i].p = geom.box[i];
+				out[i].posH = geom.boxH[i];
 				out[i].shape[0] = geom.shape[0];
 				out[i].shape[1] = geom.shape[1];
 				out[i].shape[2] = geom.shape[2];
@@ -185,13 +446,13 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 				out[i].fill = s->geom.fill ? 255 : 0;
 				out[i].attributes = geom.user_params;
 			}
-
-			vert_count += 6;
 		}	break;
 
 		case BATCH_GEOMETRY_TYPE_QUAD:
 		{
-			for (int i = 0; i < 6; ++i) {
+			for (int i = 0; i < 4; ++i) {
+				out[i].p = geom.box[i];
+				out[i].posH = geom.boxH[i];
 				out[i].shape[0] = geom.shape[0];
 				out[i].shape[1] = geom.shape[1];
 				out[i].shape[2] = geom.shape[2];
@@ -204,27 +465,12 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 				out[i].fill = s->geom.fill ? 255 : 0;
 				out[i].attributes = geom.user_params;
 			}
-
-			out[0].p = quad[0];
-			out[1].p = quad[1];
-			out[2].p = quad[2];
-			out[3].p = quad[3];
-			out[4].p = quad[4];
-			out[5].p = quad[5];
-
-			out[0].posH = quadH[0];
-			out[1].posH = quadH[1];
-			out[2].posH = quadH[2];
-			out[3].posH = quadH[3];
-			out[4].posH = quadH[4];
-			out[5].posH = quadH[5];
-		
-			vert_count += 6;
 		}	break;
 
 		case BATCH_GEOMETRY_TYPE_SPRITE:
 		{
-			for (int i = 0; i < 6; ++i) {
+			for (int i = 0; i < 4; ++i) {
+				out[i].posH = geom.shape[i];
 				out[i].alpha = (uint8_t)(s->geom.alpha * 255.0f);
 				if (s->geom.is_sprite) {
 					out[i].type = VA_TYPE_SPRITE;
@@ -237,39 +483,19 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 				out[i].attributes = geom.user_params;
 			}
 
-			out[0].posH = geom.shape[0];
-			out[0].uv.x = s->minx;
-			out[0].uv.y = s->maxy;
-
-			out[1].posH = geom.shape[3];
-			out[1].uv.x = s->minx;
-			out[1].uv.y = s->miny;
-
-			out[2].posH = geom.shape[1];
-			out[2].uv.x = s->maxx;
-			out[2].uv.y = s->maxy;
-
-			out[3].posH = geom.shape[1];
-			out[3].uv.x = s->maxx;
-			out[3].uv.y = s->maxy;
-
-			out[4].posH = geom.shape[3];
-			out[4].uv.x = s->minx;
-			out[4].uv.y = s->miny;
-
-			out[5].posH = geom.shape[2];
-			out[5].uv.x = s->maxx;
-			out[5].uv.y = s->miny;
-
-			vert_count += 6;
+			out[0].uv = cf_v2(s->minx, s->maxy);
+			out[1].uv = cf_v2(s->maxx, s->maxy);
+			out[2].uv = cf_v2(s->maxx, s->miny);
+			out[3].uv = cf_v2(s->minx, s->miny);
+			sprite_count++;
 		}	break;
 
 		case BATCH_GEOMETRY_TYPE_CIRCLE: // Use the capsule path for circle rendering.
 		case BATCH_GEOMETRY_TYPE_CAPSULE:
 		{
-			for (int i = 0; i < 6; ++i) {
-				out[i].p = quad[i];
-				out[i].posH = quadH[i];
+			for (int i = 0; i < 4; ++i) {
+				out[i].p = geom.box[i];
+				out[i].posH = geom.boxH[i];
 				out[i].shape[0] = geom.shape[0];
 				out[i].shape[1] = geom.shape[1];
 				out[i].shape[2] = geom.shape[2];
@@ -282,13 +508,11 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 				out[i].fill = s->geom.fill ? 255 : 0;
 				out[i].attributes = geom.user_params;
 			}
-
-			vert_count += 6;
 		}	break;
 
 		case BATCH_GEOMETRY_TYPE_SEGMENT:
 		{
-			for (int i = 0; i < 3; ++i) {
+			for (int i = 0; i < 4; ++i) {
 				out[i].shape[0] = geom.shape[0];
 				out[i].shape[1] = geom.shape[1];
 				out[i].shape[2] = geom.shape[2];
@@ -301,23 +525,23 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 				out[i].fill = s->geom.fill ? 255 : 0;
 				out[i].attributes = geom.user_params;
 			}
-			
+
 			out[0].p = geom.box[0];
-			out[1].p = geom.box[1];
+			out[3].p = geom.box[1];
+			out[1].p = geom.box[2];
 			out[2].p = geom.box[2];
 
 			out[0].posH = geom.boxH[0];
-			out[1].posH = geom.boxH[1];
+			out[3].posH = geom.boxH[1];
+			out[1].posH = geom.boxH[2];
 			out[2].posH = geom.boxH[2];
-		
-			vert_count += 3;
 		}	break;
 
 		case BATCH_GEOMETRY_TYPE_POLYGON:
 		{
-			for (int i = 0; i < 6; ++i) {
-				out[i].p = quad[i];
-				out[i].posH = quadH[i];
+			for (int i = 0; i < 4; ++i) {
+				out[i].p = geom.box[i];
+				out[i].posH = geom.boxH[i];
 				out[i].n = geom.n;
 				for (int j = 0; j < geom.n; ++j) {
 					out[i].shape[j] = geom.shape[j];
@@ -330,56 +554,108 @@ static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_
 				out[i].fill = 255;
 				out[i].attributes = geom.user_params;
 			}
-
-			vert_count += 6;
 		}	break;
 		}
-	}
 
-	// Allow users to optionally modulate vertices.
-	if (draw->vertex_fn) {
-		draw->vertex_fn(verts, vert_count);
+		for (int j = 0; j < 4; ++j) {
+			CF_MEMCPY(out[j].clip, geom.clip, sizeof(out[j].clip));
+		}
 	}
 
+	return sprite_count;
+}
+
+static void s_draw_report(spritebatch_sprite_t* sprites, int count, int texture_w, int texture_h, void* udata)
+{
+	CF_UNUSED(udata);
 	CF_Command& cmd = draw->cmds[draw->cmd_index];
 
-	// Map the vertex buffer with sprite vertex data.
-	cf_mesh_update_vertex_data(draw->mesh, verts, vert_count);
-	cf_apply_mesh(draw->mesh);
+	// With instancing on, each shape/sprite becomes a single instance record expanded over a shared unit quad.
+	// Triangles and segments aren't quads, so batches containing them fall through to the paths below. The
+	// vertex callback operates on `CF_Vertex`, so it forces the full vertex format.
+	CF_Shader* instanced_shader = (draw->instancing && !draw->vertex_fn) ? (CF_Shader*)draw->draw_shd_to_instanced_shd.try_get(cmd.shader.id) : NULL;
+	bool instanceable = instanced_shader != NULL;
+	for (int i = 0; instanceable && i < count; ++i) {
+		BatchGeometryType type = sprites[i].geom.type;
+		instanceable = type != BATCH_GEOMETRY_TYPE_TRI && type != BATCH_GEOMETRY_TYPE_SEGMENT;
+	}
+	if (instanceable) {
+		int first = s_fill_instances(sprites, count);
+		draw->stats.instanced_batch_count++;
+		draw->stats.vertex_bytes += (uint64_t)count * sizeof(CF_DrawInstance);
+		s_push_batch(*instanced_shader, draw->instance_mesh, 0, 4, first, count, 0, sprites->texture_id, texture_w, texture_h);
+		return;
+	}
 
-	// Apply the atlas texture.
-	CF_Texture atlas = { sprites->texture_id };
-	cf_material_set_texture_fs(draw->material, "u_image", atlas);
+	// Batches made up entirely of sprites/text use a compact vertex format with a matching shader variant.
+	CF_Shader* sprite_shader = draw->vertex_fn ? NULL : (CF_Shader*)draw->draw_shd_to_sprite_shd.try_get(cmd.shader.id);
+	bool sprites_only = sprite_shader != NULL;
+	for (int i = 0; sprites_only && i < count; ++i) {
+		sprites_only = sprites[i].geom.type == BATCH_GEOMETRY_TYPE_SPRITE;
+	}
+	if (sprites_only) {
+		int first = s_fill_sprite_verts(sprites, count);
+		s_ensure_quad_indices(count);
+		draw->stats.sprite_batch_count++;
+		draw->stats.sprite_count += count;
+		draw->stats.sprite_vertex_bytes += (uint64_t)count * 4 * sizeof(CF_SpriteVertex);
+		draw->stats.vertex_bytes += (uint64_t)count * 4 * sizeof(CF_SpriteVertex);
+		s_push_batch(*sprite_shader, draw->sprite_mesh, first, count * 4, 0, 0, count * 6, sprites->texture_id, texture_w, texture_h);
+		return;
+	}
 
-	// Apply uniforms.
-	v2 u_texture_size = cf_v2((float)texture_w, (float)texture_h);
-	cf_material_set_uniform_fs(draw->material, "u_texture_size", &u_texture_size, CF_UNIFORM_TYPE_FLOAT2, 1);
-	v2 u_texel_size = cf_v2(1.0f / (float)texture_w, 1.0f / (float)texture_h);
-	cf_material_set_uniform_fs(draw->material, "u_texel_size", &u_texel_size, CF_UNIFORM_TYPE_FLOAT2, 1);
-	cf_material_set_uniform_fs(draw->material, "u_alpha_discard", &cmd.alpha_discard, CF_UNIFORM_TYPE_FLOAT, 1);
+	// Everything else uses the full `CF_Vertex` format with four vertices per item, indexed by the static quad
+	// index buffer.
+	int first = draw->verts.count();
+	draw->verts.ensure_count(first + count * 4);
+	CF_Vertex* verts = draw->verts.data() + first;
+	int sprite_count = s_parallel_fill(s_write_verts, sprites, count, verts, (int)sizeof(CF_Vertex) * 4);
 
-	// Apply render state.
-	cf_material_set_render_state(draw->material, cmd.render_state);
+	// Allow users to optionally modulate vertices. The callback expects a plain triangle list.
+	// The quads are only scratch space in this case, so they're popped back off afterwards.
+	if (draw->vertex_fn) {
+		int first_tri = draw->tri_verts.count();
+		int vert_count = s_expand_quads(sprites, count, verts);
+		draw->verts.set_count(first);
+		draw->vertex_fn(draw->tri_verts.data() + first_tri, vert_count);
+		draw->stats.sprite_count += sprite_count;
+		draw->stats.sprite_vertex_bytes += (uint64_t)sprite_count * 6 * sizeof(CF_Vertex);
+		draw->stats.vertex_bytes += (uint64_t)vert_count * sizeof(CF_Vertex);
+		s_push_batch(cmd.shader, draw->mesh, first_tri, vert_count, 0, 0, 0, sprites->texture_id, texture_w, texture_h);
+		return;
+	}
 
-	// Kick off a draw call.
-	cf_apply_shader(cmd.shader, draw->material);
+	s_ensure_quad_indices(count);
+	draw->stats.sprite_count += sprite_count;
+	draw->stats.sprite_vertex_bytes += (uint64_t)sprite_count * 4 * sizeof(CF_Vertex);
+	draw->stats.vertex_bytes += (uint64_t)count * 4 * sizeof(CF_Vertex);
+	s_push_batch(cmd.shader, draw->quad_mesh, first, count * 4, 0, 0, count * 6, sprites->texture_id, texture_w, texture_h);
+}
 
-	// Apply viewport.
-	Rect viewport = cmd.viewport;
-	if (viewport.w >= 0 && viewport.h >= 0) {
-		cf_apply_viewport(viewport.x, viewport.y, viewport.w, viewport.h);
+// Uploads the vertices of every batch recorded by `s_draw_report` and `s_push_blit`. Each mesh gets a single
+// upload no matter how many batches were recorded, and the batches then draw from their own sub-ranges.
+static void s_upload_batches()
+{
+	if (draw->verts.count()) {
+		cf_mesh_update_vertex_data(draw->quad_mesh, draw->verts.data(), draw->verts.count());
+		draw->stats.upload_count++;
 	}
-
-	// Apply scissor.
-	Rect scissor = cmd.scissor;
-	if (scissor.w >= 0 && scissor.h >= 0) {
-		cf_apply_scissor(scissor.x, scissor.y, scissor.w, scissor.h);
+	if (draw->tri_verts.count()) {
+		cf_mesh_update_vertex_data(draw->mesh, draw->tri_verts.data(), draw->tri_verts.count());
+		draw->stats.upload_count++;
+	}
+	if (draw->sprite_verts.count()) {
+		cf_mesh_update_vertex_data(draw->sprite_mesh, draw->sprite_verts.data(), draw->sprite_verts.count());
+		draw->stats.upload_count++;
+	}
+	if (draw->instances.count()) {
+		cf_mesh_update_instance_data(draw->instance_mesh, draw->instances.data(), draw->instances.count());
+		draw->stats.upload_count++;
+	}
+	if (draw->blit_verts.count()) {
+		cf_mesh_update_vertex_data(draw->blit_mesh, draw->blit_verts.data(), draw->blit_verts.count());
+		draw->stats.upload_count++;
 	}
-
-	cf_draw_elements();
-	cf_commit();
-
-	draw->has_drawn_something = true;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -519,10 +795,188 @@ void cf_make_draw()
 		.format = CF_VERTEX_FORMAT_FLOAT4,
 		.offset = CF_OFFSET_OF(CF_Vertex, attributes),
 	});
-	draw->mesh = cf_make_mesh(CF_MB * 5, attrs.data(), attrs.count(), sizeof(CF_Vertex));
+
+	attrs.add({
+		.name = "in_clip",
+		.format = CF_VERTEX_FORMAT_SHORT4_NORM,
+		.offset = CF_OFFSET_OF(CF_Vertex, clip),
+	});
+	draw->quad_mesh = cf_make_mesh(CF_MB * 4, attrs.data(), attrs.count(), sizeof(CF_Vertex));
+
+	// Non-indexed copy of the same layout, only used while a vertex callback is set (it expects triangle lists).
+	draw->mesh = cf_make_mesh(CF_MB, attrs.data(), attrs.count(), sizeof(CF_Vertex));
+
+	// Compact mesh for sprite-only batches, see `CF_SpriteVertex`.
+	attrs.clear();
+	attrs.add({
+		.name = "in_posH",
+		.format = CF_VERTEX_FORMAT_FLOAT2,
+		.offset = CF_OFFSET_OF(CF_SpriteVertex, posH),
+	});
+
+	attrs.add({
+		.name = "in_uv",
+		.format = CF_VERTEX_FORMAT_FLOAT2,
+		.offset = CF_OFFSET_OF(CF_SpriteVertex, uv),
+	});
+
+	attrs.add({
+		.name = "in_col",
+		.format = CF_VERTEX_FORMAT_UBYTE4_NORM,
+		.offset = CF_OFFSET_OF(CF_SpriteVertex, color),
+	});
+
+	attrs.add({
+		.name = "in_params",
+		.format = CF_VERTEX_FORMAT_UBYTE4_NORM,
+		.offset = CF_OFFSET_OF(CF_SpriteVertex, type),
+	});
+
+	attrs.add({
+		.name = "in_user_params",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_SpriteVertex, attributes),
+	});
+
+	attrs.add({
+		.name = "in_clip",
+		.format = CF_VERTEX_FORMAT_SHORT4_NORM,
+		.offset = CF_OFFSET_OF(CF_SpriteVertex, clip),
+	});
+	draw->sprite_mesh = cf_make_mesh(CF_MB * 2, attrs.data(), attrs.count(), sizeof(CF_SpriteVertex));
+
+	// Both quad meshes share the same static index buffer contents, see `s_ensure_quad_indices`.
+	cf_mesh_set_index_buffer(draw->quad_mesh, 4096 * 6 * sizeof(uint16_t), 16);
+	cf_mesh_set_index_buffer(draw->sprite_mesh, 4096 * 6 * sizeof(uint16_t), 16);
+	draw->quad_index_bits = 16;
+	s_ensure_quad_indices(4096);
+
+	// Instanced mesh, a unit quad of corner indices (see `s_draw_instanced_vs`) plus one `CF_DrawInstance`
+	// per shape/sprite. The corners wind the same way as quads in `s_draw_report`.
+	attrs.clear();
+	attrs.add({
+		.name = "in_corner",
+		.format = CF_VERTEX_FORMAT_FLOAT,
+		.offset = 0,
+	});
+
+	attrs.add({
+		.name = "in_p01",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, p[0]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_p23",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, p[2]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_posH01",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, posH[0]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_posH23",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, posH[2]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_n",
+		.format = CF_VERTEX_FORMAT_INT,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, n),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_ab",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, shape[0]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_cd",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, shape[2]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_ef",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, shape[4]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_gh",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, shape[6]),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_uv_rect",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, uv_min),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_col",
+		.format = CF_VERTEX_FORMAT_UBYTE4_NORM,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, color),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_radius_stroke_aa",
+		.format = CF_VERTEX_FORMAT_FLOAT3,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, radius),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_params",
+		.format = CF_VERTEX_FORMAT_UBYTE4_NORM,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, type),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_user_params",
+		.format = CF_VERTEX_FORMAT_FLOAT4,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, attributes),
+		.per_instance = true,
+	});
+
+	attrs.add({
+		.name = "in_clip",
+		.format = CF_VERTEX_FORMAT_SHORT4_NORM,
+		.offset = CF_OFFSET_OF(CF_DrawInstance, clip),
+		.per_instance = true,
+	});
+	float corners[4] = { 0, 1, 2, 3 };
+	uint16_t corner_indices[6];
+	for (int i = 0; i < 6; ++i) corner_indices[i] = (uint16_t)s_quad_pattern[i];
+	draw->instance_mesh = cf_make_mesh(sizeof(corners), attrs.data(), attrs.count(), sizeof(float));
+	cf_mesh_set_index_buffer(draw->instance_mesh, sizeof(corner_indices), 16);
+	cf_mesh_set_instance_buffer(draw->instance_mesh, CF_MB * 2, sizeof(CF_DrawInstance));
+	cf_mesh_update_vertex_data(draw->instance_mesh, corners, 4);
+	cf_mesh_update_index_data(draw->instance_mesh, corner_indices, 6);
 
 	// Shaders.
 	draw->shaders.add(app->draw_shader);
+	draw->draw_shd_to_sprite_shd.add(app->draw_shader.id, app->draw_sprite_shader.id);
+	draw->draw_shd_to_instanced_shd.add(app->draw_shader.id, app->draw_instanced_shader.id);
 
 	// Material.
 	draw->material = cf_make_material();
@@ -551,17 +1005,94 @@ void cf_destroy_draw()
 	}
 	spritebatch_term(&draw->sb);
 	cf_destroy_mesh(draw->mesh);
+	cf_destroy_mesh(draw->quad_mesh);
+	cf_destroy_mesh(draw->sprite_mesh);
+	cf_destroy_mesh(draw->instance_mesh);
 	cf_destroy_material(draw->material);
+	cf_draw_evict_tessellations(true);
+	if (draw->capturing) {
+		cf_destroy_binary_writer(draw->capture_writer);
+	}
+	CF_Texture* replay_textures = draw->replay_textures.items();
+	for (int i = 0; i < draw->replay_textures.count(); ++i) {
+		cf_destroy_texture(replay_textures[i]);
+	}
 	draw->~CF_Draw();
 	CF_FREE(draw);
+	draw = NULL;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-void cf_draw_sprite(const CF_Sprite* sprite)
+// Transforms four points at once, e.g. the corners of a quad. `in` and `out` may alias.
+static CF_INLINE void s_mul_m32_v2x4(CF_M3x2 m, const v2* in, v2* out)
+{
+#if defined(CF_SIMD_SSE2)
+	__m128 a = _mm_loadu_ps(&in[0].x);
+	__m128 b = _mm_loadu_ps(&in[2].x);
+	__m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+	__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.m.x.x), x), _mm_mul_ps(_mm_set1_ps(m.m.y.x), y)), _mm_set1_ps(m.p.x));
+	__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m.m.x.y), x), _mm_mul_ps(_mm_set1_ps(m.m.y.y), y)), _mm_set1_ps(m.p.y));
+	_mm_storeu_ps(&out[0].x, _mm_unpacklo_ps(rx, ry));
+	_mm_storeu_ps(&out[2].x, _mm_unpackhi_ps(rx, ry));
+#elif defined(CF_SIMD_NEON)
+	float32x4x2_t v = vld2q_f32(&in[0].x);
+	float32x4x2_t r;
+	r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m.p.x), v.val[0], m.m.x.x), v.val[1], m.m.y.x);
+	r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(m.p.y), v.val[0], m.m.x.y), v.val[1], m.m.y.y);
+	vst2q_f32(&out[0].x, r);
+#else
+	for (int i = 0; i < 4; ++i) {
+		out[i] = mul(m, in[i]);
+	}
+#endif
+}
+
+// Returns the clip-space (after `draw->mvp`) bounds of an item's corners.
+static CF_Aabb s_item_bounds(const spritebatch_sprite_t& s)
 {
-	CF_ASSERT(sprite);
-	spritebatch_sprite_t s = { };
+	const v2* p = s.geom.boxH;
+	int n = 4;
+	switch (s.geom.type) {
+	case BATCH_GEOMETRY_TYPE_SPRITE: p = s.geom.shape; break;
+	case BATCH_GEOMETRY_TYPE_TRI:    p = s.geom.shape; n = 3; break;
+	case BATCH_GEOMETRY_TYPE_SEGMENT: n = 3; break;
+	default: break;
+	}
+	CF_Aabb bb;
+	bb.min = p[0];
+	bb.max = p[0];
+	for (int i = 1; i < n; ++i) {
+		bb.min = cf_min_v2(bb.min, p[i]);
+		bb.max = cf_max_v2(bb.max, p[i]);
+	}
+	return bb;
+}
+
+// Returns true if the item is entirely outside the canvas, which spans -1 to 1 on both axes in clip space.
+static bool s_is_offscreen(const spritebatch_sprite_t& s)
+{
+	CF_Aabb bb = s_item_bounds(s);
+	return bb.min.x > 1.0f || bb.min.y > 1.0f || bb.max.x < -1.0f || bb.max.y < -1.0f;
+}
+
+// Adds an item to the current command, unless culling is on and the item is entirely offscreen. Culling is
+// skipped while recording a draw list, as the list may be submitted later with a different transform.
+void cf_draw_push_item(const spritebatch_sprite_t& s)
+{
+	if (draw->culling.last() && !draw->recording && s_is_offscreen(s)) {
+		draw->stats.culled_count++;
+		return;
+	}
+	draw->add_item() = s;
+}
+
+// Fills out a spritebatch item for `sprite`, with its quad transformed by `m`.
+void cf_draw_make_sprite_item(const CF_Sprite* sprite, CF_M3x2 m, spritebatch_sprite_t* out)
+{
+	*out = { };
+	spritebatch_sprite_t& s = *out;
 	bool apply_border_scale = true;
 	if (sprite->animation) {
 		s.image_id = sprite->animation->frames[sprite->frame_index].id;
@@ -590,45 +1121,48 @@ void cf_draw_sprite(const CF_Sprite* sprite)
 		scale.y = scale.y + (scale.y / (float)sprite->h) * 2.0f;
 	}
 
-	CF_V2 quad[] = {
+	// Fold the sprite's scale, rotation and position into `m` so all four corners are transformed at once.
+	CF_M3x2 local;
+	local.m.x = V2(sprite->transform.r.c * scale.x, sprite->transform.r.s * scale.x);
+	local.m.y = V2(-sprite->transform.r.s * scale.y, sprite->transform.r.c * scale.y);
+	local.p = p;
+	static const CF_V2 quad[] = {
 		{ -0.5f,  0.5f },
 		{  0.5f,  0.5f },
 		{  0.5f, -0.5f },
 		{ -0.5f, -0.5f },
 	};
-
-	// Construct quad in local space.
-	for (int j = 0; j < 4; ++j) {
-		float x = quad[j].x;
-		float y = quad[j].y;
-
-		x *= scale.x;
-		y *= scale.y;
-
-		float x0 = sprite->transform.r.c * x - sprite->transform.r.s * y;
-		float y0 = sprite->transform.r.s * x + sprite->transform.r.c * y;
-		x = x0;
-		y = y0;
-
-		x += p.x;
-		y += p.y;
-
-		quad[j].x = x;
-		quad[j].y = y;
-	}
-
-	CF_M3x2 m = draw->mvp;
-	s.geom.shape[0] = mul(m, quad[0]);
-	s.geom.shape[1] = mul(m, quad[1]);
-	s.geom.shape[2] = mul(m, quad[2]);
-	s.geom.shape[3] = mul(m, quad[3]);
+	s_mul_m32_v2x4(cf_mul_m32(m, local), quad, s.geom.shape);
 	s.geom.is_sprite = true;
 	s.geom.color = premultiply(pixel_white());
 	s.geom.alpha = sprite->opacity;
 	s.geom.user_params = draw->user_params.last();
+}
+
+void cf_draw_sprite(const CF_Sprite* sprite)
+{
+	CF_ASSERT(sprite);
+	spritebatch_sprite_t s;
+	cf_draw_make_sprite_item(sprite, draw->mvp, &s);
 	DRAW_PUSH_ITEM(s);
 }
 
+void cf_draw_sprites(const CF_Sprite* sprites, int count)
+{
+	// Build items directly in place, reserving space for all of them up front.
+	draw->items.ensure_capacity(draw->items.count() + count);
+	bool cull = draw->culling.last() && !draw->recording;
+	CF_M3x2 m = draw->mvp;
+	for (int i = 0; i < count; ++i) {
+		spritebatch_sprite_t& s = draw->add_item();
+		cf_draw_make_sprite_item(sprites + i, m, &s);
+		if (cull && s_is_offscreen(s)) {
+			draw->pop_item();
+			draw->stats.culled_count++;
+		}
+	}
+}
+
 static void s_draw_quad(CF_V2 p0, CF_V2 p1, CF_V2 p2, CF_V2 p3, float stroke, float radius, bool fill)
 {
 	CF_M3x2 m = draw->mvp;
@@ -715,37 +1249,35 @@ void cf_draw_quad_fill2(CF_V2 p0, CF_V2 p1, CF_V2 p2, CF_V2 p3, float chubbiness
 	s_draw_quad(p0, p1, p2, p3, 0, chubbiness, true);
 }
 
-static void s_draw_circle(v2 position, float stroke, float radius, bool fill)
+static CF_INLINE void s_make_circle_item(spritebatch_sprite_t& s, CF_M3x2 m, v2 position, float stroke, float radius, bool fill, float aaf, CF_Pixel color, CF_Color user_params)
 {
-	CF_M3x2 m = draw->mvp;
-	float aaf = draw->aaf;
-	spritebatch_sprite_t s = { };
+	s = { };
 	s.image_id = app->default_image_id;
 	s.w = s.h = 1;
 	s.geom.type = BATCH_GEOMETRY_TYPE_CIRCLE;
 
-	v2 rr = V2(radius, radius);
-	v2 inflate = V2(stroke+aaf, stroke+aaf);
-	CF_Aabb bb = make_aabb(position - (rr+inflate), position + (rr+inflate));
-	cf_aabb_verts(s.geom.box, bb);
-	s.geom.box[0] = s.geom.box[0];
-	s.geom.box[1] = s.geom.box[1];
-	s.geom.box[2] = s.geom.box[2];
-	s.geom.box[3] = s.geom.box[3];
-	s.geom.boxH[0] = mul(m, s.geom.box[0]);
-	s.geom.boxH[1] = mul(m, s.geom.box[1]);
-	s.geom.boxH[2] = mul(m, s.geom.box[2]);
-	s.geom.boxH[3] = mul(m, s.geom.box[3]);
+	float inflate = radius + stroke + aaf;
+	s.geom.box[0] = V2(position.x - inflate, position.y - inflate);
+	s.geom.box[1] = V2(position.x + inflate, position.y - inflate);
+	s.geom.box[2] = V2(position.x + inflate, position.y + inflate);
+	s.geom.box[3] = V2(position.x - inflate, position.y + inflate);
+	s_mul_m32_v2x4(m, s.geom.box, s.geom.boxH);
 	s.geom.shape[0] = position;
 	s.geom.shape[1] = position;
 	s.geom.shape[2] = position;
-	s.geom.color = premultiply(to_pixel(draw->colors.last()));
+	s.geom.color = color;
 	s.geom.alpha = 1.0f;
 	s.geom.radius = radius;
 	s.geom.stroke = stroke;
 	s.geom.fill = fill;
 	s.geom.aa = aaf;
-	s.geom.user_params = draw->user_params.last();
+	s.geom.user_params = user_params;
+}
+
+static void s_draw_circle(v2 position, float stroke, float radius, bool fill)
+{
+	spritebatch_sprite_t s;
+	s_make_circle_item(s, draw->mvp, position, stroke, radius, fill, draw->aaf, premultiply(to_pixel(draw->colors.last())), draw->user_params.last());
 	DRAW_PUSH_ITEM(s);
 }
 
@@ -769,6 +1301,25 @@ void cf_draw_circle_fill2(CF_V2 position, float radius)
 	s_draw_circle(position, 0, radius, true);
 }
 
+void cf_draw_circles_fill(const CF_V2* centers, const float* radii, int count)
+{
+	// Build items directly in place, reserving space for all of them up front.
+	draw->items.ensure_capacity(draw->items.count() + count);
+	bool cull = draw->culling.last() && !draw->recording;
+	CF_M3x2 m = draw->mvp;
+	float aaf = draw->aaf;
+	CF_Pixel color = premultiply(to_pixel(draw->colors.last()));
+	CF_Color user_params = draw->user_params.last();
+	for (int i = 0; i < count; ++i) {
+		spritebatch_sprite_t& s = draw->add_item();
+		s_make_circle_item(s, m, centers[i], 0, radii[i], true, aaf, color, user_params);
+		if (cull && s_is_offscreen(s)) {
+			draw->pop_item();
+			draw->stats.culled_count++;
+		}
+	}
+}
+
 static CF_INLINE void s_bounding_box_of_capsule(v2 a, v2 b, float radius, float stroke, v2 out[4])
 {
 	float aaf = draw->aaf;
@@ -1129,102 +1680,494 @@ void cf_draw_polygon_fill(CF_V2* points, int count, float chubbiness)
 #define SIGNED_AREA_2D(A, B, C) \
 	(((B).x - (A).x) * ((C).y - (A).y) - ((B).y - (A).y) * ((C).x - (A).x))
 
-// Returns true if a point is within an oriented triangle.
-// ...Implemented as a macro to force-inline for slightly better debug perf.
-#define IS_PT_IN_TRIANGLE(A, B, C, P) \
-	(SIGNED_AREA_2D(A, B, P) > 0 && \
-	 SIGNED_AREA_2D(B, C, P) > 0 && \
-	 SIGNED_AREA_2D(C, A, P) > 0)
+enum
+{
+	TRIANGULATE_VERTEX_START,
+	TRIANGULATE_VERTEX_END,
+	TRIANGULATE_VERTEX_SPLIT,
+	TRIANGULATE_VERTEX_MERGE,
+	TRIANGULATE_VERTEX_REGULAR,
+};
+
+// Sweep order of the triangulator, top to bottom, then left to right for equal heights.
+static CF_INLINE bool s_is_above(v2 a, v2 b)
+{
+	return a.y > b.y || (a.y == b.y && a.x < b.x);
+}
+
+// Returns where edge `e` (from points[e] to points[e + 1]) crosses the horizontal line at `y`.
+static float s_edge_x_at(const CF_Triangulator* t, int e, float y)
+{
+	v2 a = t->points[e];
+	v2 b = t->points[e + 1 == t->points.count() ? 0 : e + 1];
+	if (a.y == b.y) return cf_min(a.x, b.x);
+	return a.x + (b.x - a.x) * ((y - a.y) / (b.y - a.y));
+}
+
+// Empties the sweep status, making room for one node per edge of an `n` sided polygon.
+static void s_status_reset(CF_Triangulator* t, int n)
+{
+	t->status.ensure_count(n);
+	t->status_root = -1;
+	for (int i = 0; i < n; ++i) {
+		CF_TriangulatorNode* node = t->status + i;
+		node->left = node->right = node->parent = -1;
+		// Hashed rather than random so triangulating the same polygon always gives the same result.
+		uint32_t h = (uint32_t)i * 0x9E3779B9u;
+		h ^= h >> 16;
+		h *= 0x85EBCA6Bu;
+		h ^= h >> 13;
+		node->priority = h;
+	}
+}
+
+// Rotates edge `e` of the status above its parent, keeping the left to right order.
+static void s_status_rotate_up(CF_Triangulator* t, int e)
+{
+	CF_TriangulatorNode* nodes = t->status.data();
+	int p = nodes[e].parent;
+	int g = nodes[p].parent;
+	if (nodes[p].left == e) {
+		nodes[p].left = nodes[e].right;
+		if (nodes[e].right >= 0) nodes[nodes[e].right].parent = p;
+		nodes[e].right = p;
+	} else {
+		nodes[p].right = nodes[e].left;
+		if (nodes[e].left >= 0) nodes[nodes[e].left].parent = p;
+		nodes[e].left = p;
+	}
+	nodes[p].parent = e;
+	nodes[e].parent = g;
+	if (g < 0) t->status_root = e;
+	else if (nodes[g].left == p) nodes[g].left = e;
+	else nodes[g].right = e;
+}
+
+// Returns the edge in the status directly left of `v`, or -1 if there isn't one.
+static int s_status_left_of(const CF_Triangulator* t, v2 v)
+{
+	int left = -1;
+	int e = t->status_root;
+	while (e >= 0) {
+		if (s_edge_x_at(t, e, v.y) < v.x) {
+			left = e;
+			e = t->status[e].right;
+		} else {
+			e = t->status[e].left;
+		}
+	}
+	return left;
+}
+
+static void s_status_insert(CF_Triangulator* t, int e)
+{
+	CF_TriangulatorNode* nodes = t->status.data();
+	v2 v = t->points[e];
+	int parent = -1;
+	int* link = &t->status_root;
+	while (*link >= 0) {
+		parent = *link;
+		link = s_edge_x_at(t, parent, v.y) < v.x ? &nodes[parent].right : &nodes[parent].left;
+	}
+	*link = e;
+	nodes[e].parent = parent;
+	while (nodes[e].parent >= 0 && nodes[nodes[e].parent].priority < nodes[e].priority) {
+		s_status_rotate_up(t, e);
+	}
+}
+
+static bool s_status_remove(CF_Triangulator* t, int e)
+{
+	CF_TriangulatorNode* nodes = t->status.data();
+	if (nodes[e].parent < 0 && t->status_root != e) return false;
+
+	// Rotate the edge down until it has at most one child, then splice it out.
+	while (nodes[e].left >= 0 && nodes[e].right >= 0) {
+		int l = nodes[e].left;
+		int r = nodes[e].right;
+		s_status_rotate_up(t, nodes[l].priority > nodes[r].priority ? l : r);
+	}
+	int child = nodes[e].left >= 0 ? nodes[e].left : nodes[e].right;
+	int p = nodes[e].parent;
+	if (child >= 0) nodes[child].parent = p;
+	if (p < 0) t->status_root = child;
+	else if (nodes[p].left == e) nodes[p].left = child;
+	else nodes[p].right = child;
+	nodes[e].left = nodes[e].right = nodes[e].parent = -1;
+	return true;
+}
+
+static void s_add_diagonal(CF_Triangulator* t, int a, int b)
+{
+	t->diagonals.add(a);
+	t->diagonals.add(b);
+}
+
+// Adds a triangle to the output in CCW order, mapped back to the caller's indices. Degenerate triangles are dropped.
+static void s_emit_triangle(CF_Triangulator* t, int a, int b, int c)
+{
+	float area = SIGNED_AREA_2D(t->points[a], t->points[b], t->points[c]);
+	if (area == 0) return;
+	if (area < 0) {
+		int swap = b;
+		b = c;
+		c = swap;
+	}
+	t->indices.add(t->index[a]);
+	t->indices.add(t->index[b]);
+	t->indices.add(t->index[c]);
+}
+
+// Triangulates a y-monotone polygon in linear time, given as CCW indices into `points` in `t->face`.
+static void s_triangulate_monotone(CF_Triangulator* t)
+{
+	const Array<int>& f = t->face;
+	int m = f.count();
+	if (m < 3) return;
+	if (m == 3) {
+		s_emit_triangle(t, f[0], f[1], f[2]);
+		return;
+	}
+
+	int top = 0;
+	int bottom = 0;
+	for (int i = 1; i < m; ++i) {
+		if (s_is_above(t->points[f[i]], t->points[f[top]])) top = i;
+		if (s_is_above(t->points[f[bottom]], t->points[f[i]])) bottom = i;
+	}
+
+	// Merge both chains into a single top to bottom order. Going CCW from the top walks down the left chain.
+	t->sorted.clear();
+	t->is_left.clear();
+	t->sorted.add(f[top]);
+	t->is_left.add(true);
+	int l = top + 1 == m ? 0 : top + 1;
+	int r = top == 0 ? m - 1 : top - 1;
+	while (l != bottom || r != bottom) {
+		if (r == bottom || (l != bottom && s_is_above(t->points[f[l]], t->points[f[r]]))) {
+			t->sorted.add(f[l]);
+			t->is_left.add(true);
+			l = l + 1 == m ? 0 : l + 1;
+		} else {
+			t->sorted.add(f[r]);
+			t->is_left.add(false);
+			r = r == 0 ? m - 1 : r - 1;
+		}
+	}
+	t->sorted.add(f[bottom]);
+	t->is_left.add(false);
+
+	// Stack holds positions within `sorted`.
+	Array<int>& stack = t->stack;
+	stack.clear();
+	stack.add(0);
+	stack.add(1);
+	for (int j = 2; j < m - 1; ++j) {
+		int u = t->sorted[j];
+		if (t->is_left[j] != t->is_left[stack.last()]) {
+			// Opposite chain, fan out to everything on the stack.
+			while (stack.count() > 1) {
+				int a = stack.pop();
+				s_emit_triangle(t, u, t->sorted[a], t->sorted[stack.last()]);
+			}
+			stack.clear();
+			stack.add(j - 1);
+			stack.add(j);
+		} else {
+			// Same chain, cut off triangles for as long as the diagonals stay inside the polygon.
+			int a = stack.pop();
+			while (stack.count()) {
+				v2 pu = t->points[u];
+				v2 pa = t->points[t->sorted[a]];
+				v2 pb = t->points[t->sorted[stack.last()]];
+				float area = t->is_left[j] ? SIGNED_AREA_2D(pb, pa, pu) : SIGNED_AREA_2D(pu, pa, pb);
+				if (area <= 0) break;
+				s_emit_triangle(t, u, t->sorted[a], t->sorted[stack.last()]);
+				a = stack.pop();
+			}
+			stack.add(a);
+			stack.add(j);
+		}
+	}
+	int u = t->sorted[m - 1];
+	while (stack.count() > 1) {
+		int a = stack.pop();
+		s_emit_triangle(t, u, t->sorted[a], t->sorted[stack.last()]);
+	}
+}
+
+// Triangulates a simple polygon in O(n log n), writing triples of indices into `points` to `t->indices`.
+// ...Splits the polygon into y-monotone pieces with a sweep line, then triangulates each piece in linear
+//    time, see chapter 3 of "Computational Geometry: Algorithms and Applications". The sweep status is a
+//    treap, so each step of the sweep is O(log n) no matter how many edges cross the sweep line.
+// ...Accepts CW or CCW input, and skips duplicate and collinear vertices.
+// ...Returns false for polygons that aren't simple (e.g. self-intersecting).
+bool cf_triangulate(CF_Triangulator* t, const v2* points, int count)
+{
+	t->indices.clear();
+
+	// Drop repeated and collinear vertices, they can't contribute any area.
+	t->points.clear();
+	t->index.clear();
+	for (int i = 0; i < count; ++i) {
+		v2 p = points[i];
+		while (t->points.count() >= 2 && SIGNED_AREA_2D(t->points[t->points.count() - 2], t->points.last(), p) == 0) {
+			t->points.pop();
+			t->index.pop();
+		}
+		if (t->points.count() && t->points.last().x == p.x && t->points.last().y == p.y) continue;
+		t->points.add(p);
+		t->index.add(i);
+	}
+	// Same again where the polygon wraps around, trimming from both ends.
+	int first = 0;
+	int last = t->points.count() - 1;
+	while (last - first >= 2) {
+		const v2* q = t->points.data();
+		if ((q[first].x == q[last].x && q[first].y == q[last].y) || SIGNED_AREA_2D(q[last - 1], q[last], q[first]) == 0) {
+			--last;
+		} else if (SIGNED_AREA_2D(q[last], q[first], q[first + 1]) == 0) {
+			++first;
+		} else {
+			break;
+		}
+	}
+	int n = last - first + 1;
+	if (n < 3) return true;
+	for (int i = 0; first && i < n; ++i) {
+		t->points[i] = t->points[first + i];
+		t->index[i] = t->index[first + i];
+	}
+	t->points.set_count(n);
+	t->index.set_count(n);
+
+	// Work in CCW order.
+	float area = 0;
+	for (int i = 0, j = n - 1; i < n; j = i++) {
+		area += t->points[j].x * t->points[i].y - t->points[i].x * t->points[j].y;
+	}
+	if (area < 0) {
+		for (int i = 0, j = n - 1; i < j; ++i, --j) {
+			v2 p = t->points[i]; t->points[i] = t->points[j]; t->points[j] = p;
+			int k = t->index[i]; t->index[i] = t->index[j]; t->index[j] = k;
+		}
+	}
+	const v2* p = t->points.data();
+
+	// Classify each vertex by its neighbors.
+	t->type.ensure_count(n);
+	t->order.ensure_count(n);
+	for (int i = 0; i < n; ++i) {
+		v2 prev = p[i == 0 ? n - 1 : i - 1];
+		v2 next = p[i + 1 == n ? 0 : i + 1];
+		bool convex = SIGNED_AREA_2D(prev, p[i], next) > 0;
+		if (s_is_above(p[i], prev) && s_is_above(p[i], next)) {
+			t->type[i] = convex ? TRIANGULATE_VERTEX_START : TRIANGULATE_VERTEX_SPLIT;
+		} else if (s_is_above(prev, p[i]) && s_is_above(next, p[i])) {
+			t->type[i] = convex ? TRIANGULATE_VERTEX_END : TRIANGULATE_VERTEX_MERGE;
+		} else {
+			t->type[i] = TRIANGULATE_VERTEX_REGULAR;
+		}
+		t->order[i] = i;
+	}
+	std::sort(t->order.begin(), t->order.end(), [p](int a, int b) { return s_is_above(p[a], p[b]); });
+
+	// Sweep top to bottom, adding diagonals to remove every split and merge vertex. The status holds edges
+	// of the left chains, which in CCW order point downwards, each with a helper vertex to connect to.
+	s_status_reset(t, n);
+	t->diagonals.clear();
+	t->helper.ensure_count(n);
+	int* type = t->type.data();
+	int* helper = t->helper.data();
+	for (int k = 0; k < n; ++k) {
+		int i = t->order[k];
+		int prev = i == 0 ? n - 1 : i - 1;
+		int left;
+		switch (type[i]) {
+		case TRIANGULATE_VERTEX_START:
+			s_status_insert(t, i);
+			helper[i] = i;
+			break;
+
+		case TRIANGULATE_VERTEX_END:
+			if (type[helper[prev]] == TRIANGULATE_VERTEX_MERGE) s_add_diagonal(t, i, helper[prev]);
+			if (!s_status_remove(t, prev)) return false;
+			break;
+
+		case TRIANGULATE_VERTEX_SPLIT:
+			left = s_status_left_of(t, p[i]);
+			if (left < 0) return false;
+			s_add_diagonal(t, i, helper[left]);
+			helper[left] = i;
+			s_status_insert(t, i);
+			helper[i] = i;
+			break;
 
-bool is_ear(const v2* polygon, int i, int n)
-{
-	int prev = i - 1 < 0 ? n - 1 : i - 1;
-	int next = i + 1 == n ? 0 : i + 1;
+		case TRIANGULATE_VERTEX_MERGE:
+			if (type[helper[prev]] == TRIANGULATE_VERTEX_MERGE) s_add_diagonal(t, i, helper[prev]);
+			if (!s_status_remove(t, prev)) return false;
+			left = s_status_left_of(t, p[i]);
+			if (left < 0) return false;
+			if (type[helper[left]] == TRIANGULATE_VERTEX_MERGE) s_add_diagonal(t, i, helper[left]);
+			helper[left] = i;
+			break;
+
+		case TRIANGULATE_VERTEX_REGULAR:
+			if (s_is_above(p[prev], p[i])) {
+				// On a left chain, the interior is to the right.
+				if (type[helper[prev]] == TRIANGULATE_VERTEX_MERGE) s_add_diagonal(t, i, helper[prev]);
+				if (!s_status_remove(t, prev)) return false;
+				s_status_insert(t, i);
+				helper[i] = i;
+			} else {
+				left = s_status_left_of(t, p[i]);
+				if (left < 0) return false;
+				if (type[helper[left]] == TRIANGULATE_VERTEX_MERGE) s_add_diagonal(t, i, helper[left]);
+				helper[left] = i;
+			}
+			break;
+		}
+	}
 
-	if (SIGNED_AREA_2D(polygon[prev], polygon[i], polygon[next]) <= 0) {
-		return false; // Not convex.
+	if (!t->diagonals.count()) {
+		// Already monotone.
+		t->face.ensure_count(n);
+		for (int i = 0; i < n; ++i) t->face[i] = i;
+		s_triangulate_monotone(t);
+		return true;
 	}
 
-	// Check if any other vertex is inside this triangle.
-	for (int j = 0; j < n; j++) {
-		if (j == prev || j == i || j == next) {
-			continue;
+	// Gather the outgoing half-edges of each vertex: both directions of the polygon's edges and of each
+	// diagonal, sorted CCW around the vertex. Every face traced through these, except the outside of the
+	// polygon, is one of the monotone pieces.
+	t->edge_offset.ensure_count(n + 1);
+	CF_MEMSET(t->edge_offset.data(), 0, sizeof(int) * (n + 1));
+	for (int i = 0; i < n; ++i) t->edge_offset[i + 1] += 2;
+	for (int i = 0; i < t->diagonals.count(); ++i) t->edge_offset[t->diagonals[i] + 1]++;
+	for (int i = 0; i < n; ++i) t->edge_offset[i + 1] += t->edge_offset[i];
+	int edge_count = t->edge_offset[n];
+	t->edges.ensure_count(edge_count);
+	t->edge_visited.ensure_count(edge_count);
+	t->stack.ensure_count(n);
+	int* fill = t->stack.data();
+	for (int i = 0; i < n; ++i) fill[i] = t->edge_offset[i];
+	auto add_edge = [t, p, fill](int from, int to) {
+		CF_TriangulatorEdge edge;
+		edge.to = to;
+		edge.angle = atan2f(p[to].y - p[from].y, p[to].x - p[from].x);
+		t->edges[fill[from]++] = edge;
+	};
+	for (int i = 0; i < n; ++i) {
+		add_edge(i, i + 1 == n ? 0 : i + 1);
+		add_edge(i, i == 0 ? n - 1 : i - 1);
+	}
+	for (int i = 0; i < t->diagonals.count(); i += 2) {
+		add_edge(t->diagonals[i], t->diagonals[i + 1]);
+		add_edge(t->diagonals[i + 1], t->diagonals[i]);
+	}
+	for (int i = 0; i < n; ++i) {
+		CF_TriangulatorEdge* edges = t->edges.data() + t->edge_offset[i];
+		CF_TriangulatorEdge* edges_end = t->edges.data() + t->edge_offset[i + 1];
+		std::sort(edges, edges_end, [](const CF_TriangulatorEdge& a, const CF_TriangulatorEdge& b) { return a.angle < b.angle; });
+		// Edges going CW around the polygon only border the outside, so never trace from them.
+		int prev = i == 0 ? n - 1 : i - 1;
+		for (CF_TriangulatorEdge* edge = edges; edge < edges_end; ++edge) {
+			t->edge_visited[(int)(edge - t->edges.data())] = edge->to == prev;
 		}
-		if (IS_PT_IN_TRIANGLE(polygon[prev], polygon[i], polygon[next], polygon[j])) {
-			// Another vertex is inside, not an ear.
-			return false;
+	}
+
+	// Trace each face CCW. Arriving at `v` from `u`, the next edge is the one after `v` to `u` going
+	// clockwise around `v`.
+	for (int start = 0; start < n; ++start) {
+		for (int e = t->edge_offset[start]; e < t->edge_offset[start + 1]; ++e) {
+			if (t->edge_visited[e]) continue;
+			t->face.clear();
+			int u = start;
+			int edge = e;
+			int steps = 0;
+			while (!t->edge_visited[edge]) {
+				if (steps++ > edge_count) return false;
+				t->edge_visited[edge] = true;
+				t->face.add(u);
+				int v = t->edges[edge].to;
+				int lo = t->edge_offset[v];
+				int hi = t->edge_offset[v + 1];
+				float back = atan2f(p[u].y - p[v].y, p[u].x - p[v].x);
+				int twin = (int)(std::lower_bound(t->edges.data() + lo, t->edges.data() + hi, back, [](const CF_TriangulatorEdge& a, float angle) { return a.angle < angle; }) - t->edges.data());
+				while (twin < hi && t->edges[twin].to != u) ++twin;
+				if (twin == hi) return false;
+				u = v;
+				edge = twin == lo ? hi - 1 : twin - 1;
+			}
+			if (edge != e) return false;
+			s_triangulate_monotone(t);
 		}
 	}
 
 	return true;
 }
 
-// Converts a polygon into renderable triangles.
-// ...Uses a simple ear-clipping routine.
-// ...Will produce incorrect results for: complex polygons (self-intersecting), duplicate/repeat verts,
-//    non-CCW ordering of inputs.
-v2* triangulate(v2* polygon, int n, int* out_count)
-{
-	CF_ASSERT(out_count);
-	if (n < 3) {
-		*out_count = 0;
-		return NULL;
-	}
-
-	int max_triangles = n - 2;
-	v2* triangles = (v2*)cf_alloc(max_triangles * 3 * sizeof(v2));
-	int count = 0;
-
-	int remaining = n;
-	while (remaining > 2) {
-		bool ear_found = false;
-		for (int i = 0; i < remaining; i++) {
-			if (is_ear(polygon, i, remaining)) {
-				int prev = i - 1 < 0 ? remaining - 1 : i - 1;
-				int next = i + 1 == remaining ? 0 : i + 1;
-				triangles[count] = polygon[prev];
-				triangles[count+1] = polygon[i];
-				triangles[count+2] = polygon[next];
-				count += 3;
-
-				// Remove the ear vertex by shifting the array.
-				for (int j = i; j < remaining - 1; j++) {
-					polygon[j] = polygon[j + 1];
-				}
-				remaining--;
-				ear_found = true;
-				break;
+void cf_draw_polygon_fill_simple(CF_V2* points, int count)
+{
+	CF_Triangulator* t = &draw->triangulator;
+	const Array<int>* indices = &t->indices;
+
+	if (draw->tessellation_cache) {
+		uint64_t key = cf_fnv1a(points, (int)sizeof(v2) * count);
+		CF_TessellationEntry** cached = draw->tessellations.try_get(key);
+		CF_TessellationEntry* entry = cached ? *cached : NULL;
+		if (!entry || entry->points.count() != count || CF_MEMCMP(entry->points.data(), points, sizeof(v2) * count)) {
+			if (!entry) {
+				entry = CF_NEW(CF_TessellationEntry);
+				draw->tessellations.add(key, entry);
+			}
+			entry->points.ensure_count(count);
+			CF_MEMCPY(entry->points.data(), points, sizeof(v2) * count);
+			entry->indices.clear();
+			if (cf_triangulate(t, points, count)) {
+				entry->indices = t->indices;
 			}
 		}
+		entry->used = true;
+		indices = &entry->indices;
+	} else if (!cf_triangulate(t, points, count)) {
+		return;
+	}
 
-		if (!ear_found) {
-			// If we can't find an ear, the polygon might be invalid (e.g. self-intersecting).
-			cf_free(triangles);
-			*out_count = 0;
-			return NULL;
-		}
+	for (int i = 0; i < indices->count(); i += 3) {
+		v2 a = points[(*indices)[i]];
+		v2 b = points[(*indices)[i+1]];
+		v2 c = points[(*indices)[i+2]];
+		s_draw_tri(a, b, c, 0, 0, true);
 	}
+}
 
-	*out_count = count;
-	return triangles;
+void cf_draw_set_tessellation_cache(bool true_turn_on_cache)
+{
+	draw->tessellation_cache = true_turn_on_cache;
+	if (!true_turn_on_cache) {
+		cf_draw_evict_tessellations(true);
+	}
 }
 
-void cf_draw_polygon_fill_simple(CF_V2* points, int count)
+bool cf_draw_get_tessellation_cache()
 {
-	v2* points_copy = (v2*)cf_alloc(sizeof(v2) * count);
-	CF_MEMCPY(points_copy, points, sizeof(v2) * count);
+	return draw->tessellation_cache;
+}
 
-	int n = 0;
-	v2* triangles = triangulate(points_copy, count, &n);
-	for (int i = 0; i < n; i += 3) {
-		v2 a = triangles[i];
-		v2 b = triangles[i+1];
-		v2 c = triangles[i+2];
-		s_draw_tri(a, b, c, 0, 0, true);
+// Frees cached tessellations that weren't used since the last call, or all of them.
+void cf_draw_evict_tessellations(bool all)
+{
+	for (int i = draw->tessellations.count() - 1; i >= 0; --i) {
+		CF_TessellationEntry* entry = draw->tessellations.items()[i];
+		if (all || !entry->used) {
+			entry->~CF_TessellationEntry();
+			CF_FREE(entry);
+			draw->tessellations.remove(draw->tessellations.keys()[i]);
+		} else {
+			entry->used = false;
+		}
 	}
-
-	cf_free(triangles);
-	cf_free(points_copy);
 }
 
 void cf_draw_bezier_line(CF_V2 a, CF_V2 c0, CF_V2 b, int iters, float thickness)
@@ -2383,6 +3326,25 @@ float cf_draw_peek_antialias_scale()
 	return draw->antialias_scale.last();
 }
 
+void cf_draw_push_culling(bool cull)
+{
+	draw->culling.add(cull);
+}
+
+bool cf_draw_pop_culling()
+{
+	if (draw->culling.count() > 1) {
+		return draw->culling.pop();
+	} else {
+		return draw->culling.last();
+	}
+}
+
+bool cf_draw_peek_culling()
+{
+	return draw->culling.last();
+}
+
 void cf_draw_push_vertex_attributes(float r, float g, float b, float a)
 {
 	draw->user_params.add(cf_make_color_rgba_f(r, g, b, a));
@@ -2408,6 +3370,161 @@ void cf_set_vertex_callback(CF_VertexFn* vertex_fn)
 	draw->vertex_fn = vertex_fn;
 }
 
+void cf_draw_set_instancing(bool true_turn_on_instancing)
+{
+	draw->instancing = true_turn_on_instancing;
+}
+
+bool cf_draw_get_instancing()
+{
+	return draw->instancing;
+}
+
+void cf_draw_set_parallel_threshold(int item_count)
+{
+	draw->parallel_threshold = item_count;
+}
+
+int cf_draw_get_parallel_threshold()
+{
+	return draw->parallel_threshold;
+}
+
+void cf_draw_set_batch_reordering(bool true_turn_on_reordering)
+{
+	draw->batch_reordering = true_turn_on_reordering;
+}
+
+bool cf_draw_get_batch_reordering()
+{
+	return draw->batch_reordering;
+}
+
+void cf_draw_set_vertex_scissor(bool true_turn_on_vertex_scissor)
+{
+	draw->vertex_scissor = true_turn_on_vertex_scissor;
+}
+
+bool cf_draw_get_vertex_scissor()
+{
+	return draw->vertex_scissor;
+}
+
+CF_DrawStats cf_draw_get_stats()
+{
+	return draw->stats_prev;
+}
+
+CF_DrawList cf_make_draw_list()
+{
+	CF_DrawListInternal* list = CF_NEW(CF_DrawListInternal);
+	list->inv_mvp = cf_make_identity();
+	cf_arena_init(&list->uniform_arena, 32, CF_MB);
+	CF_DrawList result = { (uint64_t)list };
+	return result;
+}
+
+void cf_destroy_draw_list(CF_DrawList list_handle)
+{
+	CF_DrawListInternal* list = (CF_DrawListInternal*)list_handle.id;
+	CF_ASSERT(draw->recording != list);
+	cf_arena_reset(&list->uniform_arena);
+	list->~CF_DrawListInternal();
+	CF_FREE(list);
+}
+
+// Copies a recorded uniform's data into `arena`, so it outlives the arena it was allocated from.
+static void s_copy_uniform_data(CF_DrawUniform* u, CF_Arena* arena)
+{
+	if (!u->data) return;
+	void* data = cf_arena_alloc(arena, u->size);
+	CF_MEMCPY(data, u->data, u->size);
+	u->data = data;
+}
+
+void cf_draw_list_begin(CF_DrawList list_handle)
+{
+	CF_DrawListInternal* list = (CF_DrawListInternal*)list_handle.id;
+	CF_ASSERT(!draw->recording);
+	list->cmds.clear();
+	list->items.clear();
+	cf_arena_reset(&list->uniform_arena);
+	list->inv_mvp = cf_invert(draw->mvp);
+	draw->recording = list;
+	draw->add_cmd();
+	draw->recording_start = draw->cmds.count() - 1;
+}
+
+void cf_draw_list_end()
+{
+	CF_DrawListInternal* list = draw->recording;
+	CF_ASSERT(list);
+	int first_item = draw->cmds[draw->recording_start].item_start;
+	for (int i = draw->recording_start; i < draw->cmds.count(); ++i) {
+		CF_Command& cmd = list->cmds.add(draw->cmds[i]);
+		cmd.item_start -= first_item;
+		s_copy_uniform_data(&cmd.u, &list->uniform_arena);
+	}
+	int item_count = draw->items.count() - first_item;
+	list->items.ensure_count(item_count);
+	CF_MEMCPY(list->items.data(), draw->items.data() + first_item, sizeof(spritebatch_sprite_t) * item_count);
+	draw->items.set_count(first_item);
+	draw->cmds.set_count(draw->recording_start);
+	draw->add_cmd();
+	draw->recording = NULL;
+}
+
+void cf_draw_list_submit(CF_DrawList list_handle, CF_M3x2 transform)
+{
+	CF_DrawListInternal* list = (CF_DrawListInternal*)list_handle.id;
+	CF_ASSERT(draw->recording != list);
+	bool cull = draw->culling.last();
+
+	// Recorded positions are already in clip space, so map them back out of the recording camera, apply
+	// `transform`, then go through the current camera.
+	CF_M3x2 m = mul(draw->mvp, mul(transform, list->inv_mvp));
+
+	for (int i = 0; i < list->cmds.count(); ++i) {
+		const CF_Command& src = list->cmds[i];
+		CF_Command& cmd = draw->cmds.add();
+		cmd.id = draw->draw_item_order++;
+		cmd.layer = src.layer;
+		cmd.scissor = src.scissor;
+		cmd.viewport = src.viewport;
+		cmd.alpha_discard = src.alpha_discard;
+		cmd.render_state = src.render_state;
+		cmd.shader = src.shader;
+		cmd.u = src.u;
+		s_copy_uniform_data(&cmd.u, &draw->uniform_arena);
+		cmd.is_canvas = src.is_canvas;
+		cmd.is_canvas_item = src.is_canvas_item;
+		cmd.canvas = src.canvas;
+		cmd.canvas_attributes = src.canvas_attributes;
+		for (int j = 0; j < 4; ++j) {
+			cmd.canvas_verts[j] = src.canvas_verts[j];
+			cmd.canvas_verts_posH[j] = mul(m, src.canvas_verts_posH[j]);
+		}
+
+		cmd.item_start = draw->items.count();
+		draw->items.ensure_capacity(draw->items.count() + src.item_count);
+		for (int j = 0; j < src.item_count; ++j) {
+			spritebatch_sprite_t& s = draw->add_item();
+			s = list->items[src.item_start + j];
+			s_mul_m32_v2x4(m, s.geom.boxH, s.geom.boxH);
+			if (s.geom.type == BATCH_GEOMETRY_TYPE_SPRITE || s.geom.type == BATCH_GEOMETRY_TYPE_TRI) {
+				s_mul_m32_v2x4(m, s.geom.shape, s.geom.shape);
+			}
+			if (cull && s_is_offscreen(s)) {
+				draw->pop_item();
+				draw->stats.culled_count++;
+			}
+		}
+	}
+
+	// Following draw calls go into a fresh command with the current state.
+	draw->add_cmd();
+}
+
 void cf_draw_push_viewport(CF_Rect viewport)
 {
 	PUSH_DRAW_VAR_AND_ADD_CMD_IF_NEEDED(viewport);
@@ -2465,19 +3582,29 @@ void cf_draw_set_atlas_dimensions(int width_in_pixels, int height_in_pixels)
 
 CF_Shader cf_make_draw_shader(const char* path)
 {
-	// Also make an attached blit shader to apply when drawing canvases.
+	// Also make an attached blit shader to apply when drawing canvases, plus sprite-only and
+	// instanced variants for batches using the compact vertex formats.
 	CF_Shader blit_shd = cf_make_draw_blit_shader_internal(path);
+	CF_Shader sprite_shd = cf_make_draw_sprite_shader_internal(path);
+	CF_Shader instanced_shd = cf_make_draw_instanced_shader_internal(path);
 	CF_Shader draw_shd = cf_make_draw_shader_internal(path);
 	draw->draw_shd_to_blit_shd.add(draw_shd.id, blit_shd.id);
+	if (sprite_shd.id) draw->draw_shd_to_sprite_shd.add(draw_shd.id, sprite_shd.id);
+	if (instanced_shd.id) draw->draw_shd_to_instanced_shd.add(draw_shd.id, instanced_shd.id);
 	return draw_shd;
 }
 
 CF_Shader cf_make_draw_shader_from_source(const char* src)
 {
-	// Also make an attached blit shader to apply when drawing canvases.
+	// Also make an attached blit shader to apply when drawing canvases, plus sprite-only and
+	// instanced variants for batches using the compact vertex formats.
 	CF_Shader blit_shd = cf_make_draw_blit_shader_from_source_internal(src);
+	CF_Shader sprite_shd = cf_make_draw_sprite_shader_from_source_internal(src);
+	CF_Shader instanced_shd = cf_make_draw_instanced_shader_from_source_internal(src);
 	CF_Shader draw_shd = cf_make_draw_shader_from_source_internal(src);
 	draw->draw_shd_to_blit_shd.add(draw_shd.id, blit_shd.id);
+	if (sprite_shd.id) draw->draw_shd_to_sprite_shd.add(draw_shd.id, sprite_shd.id);
+	if (instanced_shd.id) draw->draw_shd_to_instanced_shd.add(draw_shd.id, instanced_shd.id);
 	return draw_shd;
 }
 
@@ -2597,11 +3724,9 @@ void cf_draw_set_uniform_color(const char* name, CF_Color val)
 
 void cf_draw_canvas(CF_Canvas canvas, CF_V2 position, CF_V2 scale)
 {
-	CF_Command& cmd = draw->add_cmd();
-	cmd.is_canvas = true;
-	cmd.canvas = canvas;
+	v2 verts[4];
 	Aabb bb = make_aabb(position, fabsf(scale.x), fabsf(scale.y));
-	aabb_verts(cmd.canvas_verts, bb);
+	aabb_verts(verts, bb);
 	bool flip_x = scale.x < 0;
 	bool flip_y = scale.y < 0;
 	auto swap = [](v2& a, v2& b) {
@@ -2610,29 +3735,92 @@ void cf_draw_canvas(CF_Canvas canvas, CF_V2 position, CF_V2 scale)
 		b = t;
 	};
 	if (flip_x) {
-		swap(cmd.canvas_verts[0], cmd.canvas_verts[1]);
-		swap(cmd.canvas_verts[2], cmd.canvas_verts[3]);
+		swap(verts[0], verts[1]);
+		swap(verts[2], verts[3]);
 	}
 	if (flip_y) {
-		swap(cmd.canvas_verts[0], cmd.canvas_verts[3]);
-		swap(cmd.canvas_verts[1], cmd.canvas_verts[2]);
+		swap(verts[0], verts[3]);
+		swap(verts[1], verts[2]);
+	}
+
+	// With the default shader a canvas is just a textured quad, so it's drawn like a premade sprite with the same
+	// pipeline and vertex buffer as everything else. Its texture is registered on first use, and unregistered by
+	// `cf_destroy_canvas`. Custom shaders may depend on the world position handed to their blit variant, so they
+	// still get a dedicated blit.
+	if (draw->shaders.last().id == app->draw_shader.id) {
+		CF_CanvasInternal* canvas_internal = (CF_CanvasInternal*)canvas.id;
+		uint64_t image_id = CF_CANVAS_ID_RANGE_LO + canvas.id;
+		if (!canvas_internal->premade_registered) {
+			spritebatch_premade_sprite_t premade = { };
+			premade.image_id = image_id;
+			premade.w = canvas_internal->w;
+			premade.h = canvas_internal->h;
+			premade.maxx = 1.0f;
+			premade.maxy = 1.0f;
+			spritebatch_register_premade_atlas(&draw->sb, canvas_internal->cf_texture.id, canvas_internal->w, canvas_internal->h, 1, &premade);
+			canvas_internal->premade_registered = true;
+		}
+
+		// The spritebatch sorts by texture when flushing, which would reorder the canvas against anything else in
+		// the same flush. Give it a command of its own to flush before and after it, which only merges with other
+		// draws of this same canvas.
+		draw->add_cmd().is_canvas_item = true;
+		spritebatch_sprite_t s = { };
+		s.image_id = image_id;
+		s.texture_id = canvas_internal->cf_texture.id;
+		s.w = canvas_internal->w;
+		s.h = canvas_internal->h;
+		s.maxx = 1.0f;
+		s.maxy = 1.0f;
+		s.geom.type = BATCH_GEOMETRY_TYPE_SPRITE;
+		s_mul_m32_v2x4(draw->mvp, verts, s.geom.shape);
+		s.geom.is_sprite = true;
+		s.geom.color = premultiply(pixel_white());
+		s.geom.alpha = 1.0f;
+		s.geom.user_params = draw->user_params.last();
+		DRAW_PUSH_ITEM(s);
+		draw->add_cmd();
+		return;
 	}
+
+	CF_Command& cmd = draw->add_cmd();
+	cmd.is_canvas = true;
+	cmd.canvas = canvas;
 	for (int i = 0; i < 4; ++i) {
-		cmd.canvas_verts_posH[i] = mul(draw->mvp, cmd.canvas_verts[i]);
+		cmd.canvas_verts[i] = verts[i];
+		cmd.canvas_verts_posH[i] = mul(draw->mvp, verts[i]);
 	}
 	cmd.canvas_attributes = draw->user_params.last();
 }
 
-void static s_blit(CF_Command* cmd, CF_Canvas src, CF_Canvas dst, bool clear_dst)
+// Returns the texture drawn by a command from `cf_draw_canvas`, or 0 if it has nothing to draw.
+static uint64_t s_canvas_item_texture(const CF_Command& cmd)
+{
+	return cmd.item_count ? draw->items[cmd.item_start].texture_id : 0;
+}
+
+// Returns true if `b` can be drawn in the same batch as `a`, i.e. all of their render state matches.
+static bool s_can_merge(const CF_Command& a, const CF_Command& b)
 {
-	typedef struct Vertex
-	{
-		v2 pos;  // World space x/y.
-		v2 posH; // posH, homogenous (multiplied by mvp).
-		v2 uv;   // UV to read from src.
-		CF_Color params;
-	} Vertex;
+	// Canvases only merge with draws of the same canvas, as the spritebatch would otherwise sort them against other
+	// textures in the flush, breaking painter's order.
+	if (a.is_canvas_item != b.is_canvas_item) return false;
+	if (a.is_canvas_item && s_canvas_item_texture(a) != s_canvas_item_texture(b)) return false;
+	if (a.u.size != b.u.size) return false;
+	if (a.u.type != b.u.type) return false;
+	if (a.u.texture.id != b.u.texture.id) return false;
+	if (a.u.name != b.u.name) return false;
+	if (CF_MEMCMP(a.u.data, b.u.data, a.u.size)) return false;
+	return a.alpha_discard == b.alpha_discard &&
+	       a.render_state == b.render_state &&
+	       (draw->vertex_scissor || a.scissor == b.scissor) &&
+	       a.shader == b.shader &&
+	       a.viewport == b.viewport;
+}
 
+// Creates the mesh canvases are blitted with, the first time one is drawn.
+static void s_init_blit_mesh()
+{
 	if (!draw->blit_init) {
 		draw->blit_init = true;
 
@@ -2640,19 +3828,25 @@ void static s_blit(CF_Command* cmd, CF_Canvas src, CF_Canvas dst, bool clear_dst
 		CF_VertexAttribute attrs[4] = { 0 };
 		attrs[0].name = "in_pos";
 		attrs[0].format = CF_VERTEX_FORMAT_FLOAT2;
-		attrs[0].offset = CF_OFFSET_OF(Vertex, pos);
+		attrs[0].offset = CF_OFFSET_OF(CF_BlitVertex, pos);
 		attrs[1].name = "in_posH";
 		attrs[1].format = CF_VERTEX_FORMAT_FLOAT2;
-		attrs[1].offset = CF_OFFSET_OF(Vertex, posH);
+		attrs[1].offset = CF_OFFSET_OF(CF_BlitVertex, posH);
 		attrs[2].name = "in_uv";
 		attrs[2].format = CF_VERTEX_FORMAT_FLOAT2;
-		attrs[2].offset = CF_OFFSET_OF(Vertex, uv);
+		attrs[2].offset = CF_OFFSET_OF(CF_BlitVertex, uv);
 		attrs[3].name = "in_params";
 		attrs[3].format = CF_VERTEX_FORMAT_FLOAT4;
-		attrs[3].offset = CF_OFFSET_OF(Vertex, params);
-		CF_Mesh blit_mesh = cf_make_mesh(sizeof(Vertex) * 1024, attrs, CF_ARRAY_SIZE(attrs), sizeof(Vertex));
+		attrs[3].offset = CF_OFFSET_OF(CF_BlitVertex, params);
+		CF_Mesh blit_mesh = cf_make_mesh(sizeof(CF_BlitVertex) * 1024, attrs, CF_ARRAY_SIZE(attrs), sizeof(CF_BlitVertex));
 		draw->blit_mesh = blit_mesh;
 	}
+}
+
+// Records a blit of `cmd->canvas` onto the render target as six vertices, drawn later by `s_blit`.
+static void s_push_blit(CF_Command* cmd)
+{
+	s_init_blit_mesh();
 
 	// Try and fetch a custom shader supplied by the user, otherwise fallback to the default blit shader.
 	CF_Shader* blit = (CF_Shader*)draw->draw_shd_to_blit_shd.try_get(cmd->shader.id);
@@ -2661,8 +3855,6 @@ void static s_blit(CF_Command* cmd, CF_Canvas src, CF_Canvas dst, bool clear_dst
 		blit = (CF_Shader*)&app->blit_shader;
 	}
 
-	cf_apply_canvas(dst, clear_dst);
-
 	// Matches index convention from `bb_verts` function.
 	v2 verts_world[6] = {
 		cmd->canvas_verts[0],
@@ -2680,10 +3872,13 @@ void static s_blit(CF_Command* cmd, CF_Canvas src, CF_Canvas dst, bool clear_dst
 		cmd->canvas_verts_posH[2],
 		cmd->canvas_verts_posH[3],
 	};
-	Vertex verts[6];
+	int first = draw->blit_verts.count();
+	draw->blit_verts.ensure_count(first + 6);
+	CF_BlitVertex* verts = draw->blit_verts.data() + first;
 	for (int i = 0; i < 6; ++i) {
 		verts[i].pos = verts_world[i];
 		verts[i].posH = verts_posH[i];
+		verts[i].params = cmd->canvas_attributes;
 	}
 	verts[0].uv = V2(0,1);
 	verts[1].uv = V2(1,1);
@@ -2692,32 +3887,66 @@ void static s_blit(CF_Command* cmd, CF_Canvas src, CF_Canvas dst, bool clear_dst
 	verts[4].uv = V2(1,0);
 	verts[5].uv = V2(0,0);
 
-	cf_mesh_update_vertex_data(draw->blit_mesh, verts, 6);
-	cf_apply_mesh(draw->blit_mesh);
+	// Consecutive blits of the same canvas with the same state share a single draw call, provided no uniforms
+	// were set in between.
+	if (draw->batches.count()) {
+		CF_DrawBatch& prev = draw->batches.last();
+		const CF_Command& prev_cmd = draw->cmds[prev.cmd_index];
+		bool mergeable = prev.is_blit && prev.shader.id == blit->id && prev.first_vertex + prev.vertex_count == first;
+		mergeable = mergeable && prev_cmd.canvas.id == cmd->canvas.id && prev_cmd.scissor == cmd->scissor && s_can_merge(prev_cmd, *cmd);
+		for (int i = prev.cmd_index + 1; mergeable && i < draw->cmd_index; ++i) {
+			mergeable = !draw->cmds[i].u.name;
+		}
+		if (mergeable) {
+			prev.vertex_count += 6;
+			prev.cmd_index = draw->cmd_index;
+			return;
+		}
+	}
+
+	CF_DrawBatch batch = { };
+	batch.cmd_index = draw->cmd_index;
+	batch.shader = *blit;
+	batch.mesh = draw->blit_mesh;
+	batch.first_vertex = first;
+	batch.vertex_count = 6;
+	batch.texture_id = cf_canvas_get_target(cmd->canvas).id;
+	batch.texture_w = ((CF_CanvasInternal*)cmd->canvas.id)->w;
+	batch.texture_h = ((CF_CanvasInternal*)cmd->canvas.id)->h;
+	batch.is_blit = true;
+	draw->batches.add(batch);
+	draw->has_drawn_something = true;
+}
+
+static void s_blit(const CF_DrawBatch& batch, const CF_Command& cmd)
+{
+	cf_mesh_set_draw_range(batch.mesh, batch.first_vertex, batch.vertex_count, 0, 0);
+	cf_apply_mesh(batch.mesh);
 
 	// Read pixels from src.
-	cf_material_set_texture_fs(draw->material, "u_image", cf_canvas_get_target(src));
+	CF_Texture src = { batch.texture_id };
+	cf_material_set_texture_fs(draw->material, "u_image", src);
 
 	// Apply uniforms.
-	CF_CanvasInternal* canvas_internal = (CF_CanvasInternal*)cmd->canvas.id;
-	v2 canvas_dims = V2((float)canvas_internal->w, (float)canvas_internal->h);
+	v2 canvas_dims = V2((float)batch.texture_w, (float)batch.texture_h);
 	cf_material_set_uniform_fs(draw->material, "u_texture_size", &canvas_dims, CF_UNIFORM_TYPE_FLOAT2, 1);
-	cf_material_set_uniform_fs(draw->material, "u_alpha_discard", &cmd->alpha_discard, CF_UNIFORM_TYPE_FLOAT, 1);
+	float alpha_discard = cmd.alpha_discard;
+	cf_material_set_uniform_fs(draw->material, "u_alpha_discard", &alpha_discard, CF_UNIFORM_TYPE_FLOAT, 1);
 	
 	// Apply render state.
-	cf_material_set_render_state(draw->material, cmd->render_state);
+	cf_material_set_render_state(draw->material, cmd.render_state);
 
 	// Apply shader.
-	cf_apply_shader(*blit, draw->material);
+	cf_apply_shader(batch.shader, draw->material);
 
 	// Apply viewport.
-	Rect viewport = cmd->viewport;
+	Rect viewport = cmd.viewport;
 	if (viewport.w >= 0 && viewport.h >= 0) {
 		cf_apply_viewport(viewport.x, viewport.y, viewport.w, viewport.h);
 	}
 
 	// Apply scissor.
-	Rect scissor = cmd->scissor;
+	Rect scissor = cmd.scissor;
 	if (scissor.w >= 0 && scissor.h >= 0) {
 		cf_apply_scissor(scissor.x, scissor.y, scissor.w, scissor.h);
 	}
@@ -2726,9 +3955,260 @@ void static s_blit(CF_Command* cmd, CF_Canvas src, CF_Canvas dst, bool clear_dst
 	cf_draw_elements();
 }
 
+static void s_apply_uniform(CF_Command* cmd)
+{
+	CF_DrawUniform* u = &cmd->u;
+	if (u->is_texture) {
+		material_set_texture_fs(draw->material, u->name, u->texture);
+	} else if (u->data) {
+		cf_material_set_uniform_fs_internal(draw->material, "shd_uniforms", u->name, u->data, u->type, u->array_length);
+	}
+}
+
+// Stores a command's scissor on each of its items as a clip-space rectangle, see `CF_Vertex::clip`. Without a
+// scissor (or when using the hardware scissor) the rectangle covers the whole viewport.
+static void s_set_item_clip(const CF_Command& cmd, int canvas_w, int canvas_h)
+{
+	int16_t clip[4] = { -32767, -32767, 32767, 32767 };
+	CF_Rect scissor = cmd.scissor;
+	if (draw->vertex_scissor && scissor.w >= 0 && scissor.h >= 0) {
+		// Scissors are in pixels from the top-left of the canvas, while clip space spans -1 to 1 across the viewport.
+		CF_Rect viewport = cmd.viewport;
+		if (viewport.w < 0 || viewport.h < 0) {
+			viewport = { 0, 0, canvas_w, canvas_h };
+		}
+		float sx = 2.0f / (float)cf_max(viewport.w, 1);
+		float sy = 2.0f / (float)cf_max(viewport.h, 1);
+		float x0 = (float)(scissor.x - viewport.x) * sx - 1.0f;
+		float x1 = (float)(scissor.x + scissor.w - viewport.x) * sx - 1.0f;
+		float y0 = 1.0f - (float)(scissor.y + scissor.h - viewport.y) * sy;
+		float y1 = 1.0f - (float)(scissor.y - viewport.y) * sy;
+		clip[0] = (int16_t)(cf_clamp(x0, -1.0f, 1.0f) * 32767.0f);
+		clip[1] = (int16_t)(cf_clamp(y0, -1.0f, 1.0f) * 32767.0f);
+		clip[2] = (int16_t)(cf_clamp(x1, -1.0f, 1.0f) * 32767.0f);
+		clip[3] = (int16_t)(cf_clamp(y1, -1.0f, 1.0f) * 32767.0f);
+	}
+	spritebatch_sprite_t* items = draw->items.data() + cmd.item_start;
+	for (int i = 0; i < cmd.item_count; ++i) {
+		CF_MEMCPY(items[i].geom.clip, clip, sizeof(clip));
+	}
+}
+
+// Returns the first command from `i` onwards with items to draw, a canvas to blit or a uniform to apply, or `count`.
+// Anything in between can be skipped over when merging.
+static int s_next_merge_cmd(const CF_Command* cmds, int i, int count)
+{
+	while (i < count && !cmds[i].is_canvas && !cmds[i].item_count && !cmds[i].u.name) ++i;
+	return i;
+}
+
+// Counts how many times `cf_render_to` will flush the spritebatch for these commands.
+static int s_count_flushes(const CF_Command* cmds, int count)
+{
+	int flushes = 0;
+	for (int i = 0; i < count; ++i) {
+		if (cmds[i].is_canvas || !cmds[i].item_count) continue;
+		int next = s_next_merge_cmd(cmds, i + 1, count);
+		if (next == count || !s_can_merge(cmds[i], cmds[next])) ++flushes;
+	}
+	return flushes;
+}
+
+// How many commands a command may be moved past while looking for others with matching state.
+#define CF_DRAW_REORDER_WINDOW 64
+
+// Reorders the (already sorted) commands within each layer so commands with matching state end up next to each
+// other and merge into a single batch. A command is only moved earlier past commands it doesn't overlap, so
+// anything overlapping keeps its painter's order. Uniforms and canvas blits are never moved, and nothing is moved
+// across them, since uniforms stay applied to everything after them. Nothing is moved across a change of viewport
+// either, as item bounds are in clip space and only comparable within the same viewport. Commands without any
+// items are dropped.
+static void s_reorder_cmds()
+{
+	int count = draw->cmds.count();
+	int flushes_before = s_count_flushes(draw->cmds.data(), count);
+
+	draw->reorder_bounds.ensure_count(count);
+	for (int i = 0; i < count; ++i) {
+		const CF_Command& cmd = draw->cmds[i];
+		if (!cmd.item_count) continue;
+		const spritebatch_sprite_t* items = draw->items.data() + cmd.item_start;
+		CF_Aabb bb = s_item_bounds(items[0]);
+		for (int j = 1; j < cmd.item_count; ++j) {
+			bb = cf_combine(bb, s_item_bounds(items[j]));
+		}
+		draw->reorder_bounds[i] = bb;
+	}
+
+	draw->reorder_cmds.clear();
+	draw->reorder_cmds.ensure_capacity(count);
+	int i = 0;
+	while (i < count) {
+		const CF_Command& barrier = draw->cmds[i];
+		if (barrier.is_canvas || barrier.u.name) {
+			draw->reorder_cmds.add(barrier);
+			++i;
+			continue;
+		}
+
+		// Gather a run of reorderable commands within a single layer and viewport.
+		draw->reorder_pending.clear();
+		int layer = barrier.layer;
+		CF_Rect viewport = barrier.viewport;
+		for (; i < count; ++i) {
+			const CF_Command& cmd = draw->cmds[i];
+			if (cmd.is_canvas || cmd.u.name || cmd.layer != layer || !(cmd.viewport == viewport)) break;
+			if (cmd.item_count) draw->reorder_pending.add(i);
+		}
+
+		// Greedily emit the oldest pending command, then pull forward every later command with matching state
+		// that doesn't overlap any of the commands it would jump over.
+		int* pending = draw->reorder_pending.data();
+		int pending_count = draw->reorder_pending.count();
+		int first = 0;
+		while (first < pending_count) {
+			const CF_Command& key = draw->cmds[pending[first]];
+			draw->reorder_cmds.add(key);
+			pending[first] = -1;
+			draw->reorder_skipped.clear();
+			for (int j = first + 1; j < pending_count && draw->reorder_skipped.count() < CF_DRAW_REORDER_WINDOW; ++j) {
+				int index = pending[j];
+				if (index < 0) continue;
+				bool movable = s_can_merge(key, draw->cmds[index]);
+				for (int k = 0; movable && k < draw->reorder_skipped.count(); ++k) {
+					movable = !cf_overlaps(draw->reorder_bounds[index], draw->reorder_bounds[draw->reorder_skipped[k]]);
+				}
+				if (movable) {
+					draw->reorder_cmds.add(draw->cmds[index]);
+					pending[j] = -1;
+				} else {
+					draw->reorder_skipped.add(index);
+				}
+			}
+			while (first < pending_count && pending[first] < 0) ++first;
+		}
+	}
+
+	int new_count = draw->reorder_cmds.count();
+	for (int j = 0; j < new_count; ++j) {
+		draw->cmds[j] = draw->reorder_cmds[j];
+	}
+	draw->cmds.set_count(new_count);
+	draw->stats.batches_saved += flushes_before - s_count_flushes(draw->cmds.data(), new_count);
+}
+
+// Vertex strides of each `CF_DrawCaptureMesh`.
+static const uint32_t s_capture_strides[CF_DRAW_CAPTURE_MESH_COUNT] = {
+	sizeof(CF_Vertex),
+	sizeof(CF_Vertex),
+	sizeof(CF_SpriteVertex),
+	sizeof(CF_DrawInstance),
+	sizeof(CF_BlitVertex),
+};
+
+static CF_Mesh s_capture_mesh(int mesh)
+{
+	switch (mesh) {
+	case CF_DRAW_CAPTURE_MESH_TRIS:      return draw->mesh;
+	case CF_DRAW_CAPTURE_MESH_QUADS:     return draw->quad_mesh;
+	case CF_DRAW_CAPTURE_MESH_SPRITES:   return draw->sprite_mesh;
+	case CF_DRAW_CAPTURE_MESH_INSTANCES: return draw->instance_mesh;
+	default:                             return draw->blit_mesh;
+	}
+}
+
+// The built-in shader each mesh is drawn with. Anything else came from `cf_make_draw_shader`.
+static CF_Shader s_capture_shader(int mesh)
+{
+	switch (mesh) {
+	case CF_DRAW_CAPTURE_MESH_SPRITES:   return app->draw_sprite_shader;
+	case CF_DRAW_CAPTURE_MESH_INSTANCES: return app->draw_instanced_shader;
+	case CF_DRAW_CAPTURE_MESH_BLITS:     return app->blit_shader;
+	default:                             return app->draw_shader;
+	}
+}
+
+static void s_capture_uniform(const CF_DrawUniform& u)
+{
+	if (!u.name || u.is_texture || !u.data) return;
+	CF_DrawCaptureUniform cu;
+	cu.name = cf_binary_writer_add_string(draw->capture_writer, u.name);
+	cu.type = (int32_t)u.type;
+	cu.array_length = u.array_length;
+	cu.size = u.size;
+	cu.data_offset = (uint64_t)draw->capture_uniform_data.count();
+	draw->capture_uniform_data.ensure_count(draw->capture_uniform_data.count() + u.size);
+	CF_MEMCPY(draw->capture_uniform_data.data() + cu.data_offset, u.data, u.size);
+	draw->capture_uniforms.add(cu);
+}
+
+// Appends everything `cf_render_to` is about to draw to the capture started by `cf_draw_capture_begin`. Must be
+// called after `s_upload_batches`, once the vertices of every batch are final.
+static void s_capture_pass(CF_CanvasInternal* target, bool clear)
+{
+	CF_DrawCapturePass pass = { };
+	pass.canvas_w = target->w;
+	pass.canvas_h = target->h;
+	pass.clear = clear ? 1 : 0;
+	pass.batch_start = draw->capture_batches.count();
+	pass.batch_count = draw->batches.count();
+
+	const void* verts[CF_DRAW_CAPTURE_MESH_COUNT] = { draw->tri_verts.data(), draw->verts.data(), draw->sprite_verts.data(), draw->instances.data(), draw->blit_verts.data() };
+	int counts[CF_DRAW_CAPTURE_MESH_COUNT] = { draw->tri_verts.count(), draw->verts.count(), draw->sprite_verts.count(), draw->instances.count(), draw->blit_verts.count() };
+	for (int i = 0; i < CF_DRAW_CAPTURE_MESH_COUNT; ++i) {
+		int size = counts[i] * (int)s_capture_strides[i];
+		pass.vertex_count[i] = counts[i];
+		pass.vertex_offset[i] = (uint64_t)draw->capture_vertices.count();
+		draw->capture_vertices.ensure_count(draw->capture_vertices.count() + size);
+		if (size) CF_MEMCPY(draw->capture_vertices.data() + pass.vertex_offset[i], verts[i], size);
+	}
+
+	// Uniforms are applied in between batches exactly as `cf_render_to` does.
+	int uniform_index = 0;
+	for (int i = 0; i < draw->batches.count(); ++i) {
+		const CF_DrawBatch& batch = draw->batches[i];
+		const CF_Command& cmd = draw->cmds[batch.cmd_index];
+		CF_DrawCaptureBatch b = { };
+		b.uniform_start = draw->capture_uniforms.count();
+		for (; uniform_index <= batch.cmd_index; ++uniform_index) {
+			s_capture_uniform(draw->cmds[uniform_index].u);
+		}
+		b.uniform_count = draw->capture_uniforms.count() - b.uniform_start;
+		b.mesh = CF_DRAW_CAPTURE_MESH_BLITS;
+		for (int j = 0; j < CF_DRAW_CAPTURE_MESH_COUNT; ++j) {
+			if (s_capture_mesh(j).id == batch.mesh.id) {
+				b.mesh = j;
+				break;
+			}
+		}
+		b.first_vertex = batch.first_vertex;
+		b.vertex_count = batch.vertex_count;
+		b.first_instance = batch.first_instance;
+		b.instance_count = batch.instance_count;
+		b.index_count = batch.index_count;
+		b.texture_w = batch.texture_w;
+		b.texture_h = batch.texture_h;
+		b.texture_id = batch.texture_id;
+		b.custom_shader = batch.shader.id != s_capture_shader(b.mesh).id ? 1 : 0;
+		b.alpha_discard = cmd.alpha_discard;
+		b.viewport = cmd.viewport;
+		b.scissor = (!batch.is_blit && draw->vertex_scissor) ? CF_Rect{ 0, 0, -1, -1 } : cmd.scissor;
+		b.render_state = cmd.render_state;
+		draw->capture_batches.add(b);
+	}
+	pass.uniform_start = draw->capture_uniforms.count();
+	for (; uniform_index < draw->cmds.count(); ++uniform_index) {
+		s_capture_uniform(draw->cmds[uniform_index].u);
+	}
+	pass.uniform_count = draw->capture_uniforms.count() - pass.uniform_start;
+	draw->capture_passes.add(pass);
+}
+
 void cf_render_to(CF_Canvas canvas, bool clear)
 {
+	CF_ASSERT(!draw->recording);
 	cf_apply_canvas(canvas, clear);
+	CF_CanvasInternal* target = (CF_CanvasInternal*)canvas.id;
 
 	// Sort the commands by layer first, then by age (to maintain relative ordering).
 	// @NOTE -- Perhaps std::sort would be better than stable_sort, since the predicate has stability built-in?
@@ -2736,74 +4216,324 @@ void cf_render_to(CF_Canvas canvas, bool clear)
 		if (a.layer == b.layer) return a.id < b.id;
 		else return a.layer < b.layer;
 	});
+	if (draw->batch_reordering) {
+		s_reorder_cmds();
+	}
 
+	// Record all of the batches first, so their vertices can be uploaded in one go.
 	int count = draw->cmds.count();
 	for (int i = 0; i < count; ++i) {
 		draw->cmd_index = i;
 		CF_Command* cmd = &draw->cmds[i];
 
-		// Apply uniforms.
-		CF_DrawUniform* u = &cmd->u;
-		if (u->is_texture) {
-			material_set_texture_fs(draw->material, u->name, u->texture);
-		} else if (u->data) {
-			cf_material_set_uniform_fs_internal(draw->material, "shd_uniforms", u->name, u->data, u->type, u->array_length);
-		}
-
-		// Blit canvas.
+		// Blit a canvas drawn with a custom shader.
 		// ...Incurs an entire extra draw call by itself.
 		if (cmd->is_canvas) {
-			s_blit(cmd, cmd->canvas, canvas, clear);
-			clear = false; // Only clear `canvas` once.
-			draw->has_drawn_something = true;
+			// Anything still collated in the spritebatch was submitted before the canvas, so draw it first.
+			spritebatch_flush(&draw->sb);
+			s_push_blit(cmd);
 			continue;
 		}
 
 		// Collate all of the drawable items into the spritebatch.
-		if (!cmd->items.count()) continue;
-		for (int j = 0; j < cmd->items.count(); ++j) {
-			spritebatch_push(&draw->sb, cmd->items[j]);
-		}
+		if (!cmd->item_count) continue;
+		s_set_item_clip(*cmd, target->w, target->h);
+		spritebatch_push_array(&draw->sb, draw->items.data() + cmd->item_start, cmd->item_count);
 
 		// Merge with the next command if identical.
-		CF_Command* next = i + 1 == count ? NULL : draw->cmds + (i + 1);
-		if (next) {
-			if (next->u.size != cmd->u.size) {
-				continue;
-			}
-			if (next->u.type != cmd->u.type) {
-				continue;
-			}
-			if (next->u.texture.id != cmd->u.texture.id) {
-				continue;
-			}
-			if (next->u.name != cmd->u.name) {
-				continue;
-			}
-			if (CF_MEMCMP(next->u.data, cmd->u.data, next->u.size)) {
-				continue;
-			}
-			if (next->alpha_discard == cmd->alpha_discard &&
-			    next->render_state == cmd->render_state &&
-			    next->scissor == cmd->scissor &&
-			    next->shader == cmd->shader &&
-			    next->viewport == cmd->viewport) {
-				continue;
-			}
+		int next = s_next_merge_cmd(draw->cmds.data(), i + 1, count);
+		if (next < count && s_can_merge(*cmd, draw->cmds[next])) {
+			continue;
 		}
 
 		// Process the collated drawable items. Might get split up into multiple draw calls depending on
 		// the atlas compiler.
 		spritebatch_flush(&draw->sb);
 	}
+
+	s_upload_batches();
+	if (draw->capturing) {
+		s_capture_pass(target, clear);
+	}
+
+	// Issue the draw calls, applying uniforms from each command along the way. They all share one render
+	// pass, ended by `cf_commit` once the last batch is drawn.
+	int uniform_index = 0;
+	for (int i = 0; i < draw->batches.count(); ++i) {
+		const CF_DrawBatch& batch = draw->batches[i];
+		for (; uniform_index <= batch.cmd_index; ++uniform_index) {
+			s_apply_uniform(draw->cmds + uniform_index);
+		}
+		if (batch.is_blit) {
+			s_blit(batch, draw->cmds[batch.cmd_index]);
+		} else {
+			s_draw_batch(batch, draw->cmds[batch.cmd_index]);
+		}
+	}
+	for (; uniform_index < count; ++uniform_index) {
+		s_apply_uniform(draw->cmds + uniform_index);
+	}
+	cf_commit();
+
 	if (clear && !draw->has_drawn_something) {
 		cf_clear_canvas(canvas);
 	}
 	draw->has_drawn_something = false;
 	cf_arena_reset(&draw->uniform_arena);
 	draw->cmds.clear();
+	draw->items.clear();
 	draw->add_cmd();
 	draw->verts.clear();
+	draw->tri_verts.clear();
+	draw->sprite_verts.clear();
+	draw->instances.clear();
+	draw->blit_verts.clear();
+	draw->batches.clear();
+}
+
+void cf_draw_capture_begin()
+{
+	CF_ASSERT(!draw->capturing);
+	draw->capturing = true;
+	draw->capture_writer = cf_make_binary_writer();
+	draw->capture_passes.clear();
+	draw->capture_batches.clear();
+	draw->capture_uniforms.clear();
+	draw->capture_uniform_data.clear();
+	draw->capture_vertices.clear();
+}
+
+CF_Result cf_draw_capture_end(const char* path)
+{
+	CF_ASSERT(draw->capturing);
+	draw->capturing = false;
+
+	CF_DrawCaptureHeader header;
+	header.version = CF_DRAW_CAPTURE_VERSION;
+	header.pass_size = sizeof(CF_DrawCapturePass);
+	header.batch_size = sizeof(CF_DrawCaptureBatch);
+	header.uniform_size = sizeof(CF_DrawCaptureUniform);
+	CF_MEMCPY(header.strides, s_capture_strides, sizeof(header.strides));
+
+	CF_BinaryWriter w = draw->capture_writer;
+	cf_binary_writer_add_section(w, "draw.header", &header, sizeof(header));
+	cf_binary_writer_add_section(w, "draw.passes", draw->capture_passes.data(), sizeof(CF_DrawCapturePass) * draw->capture_passes.count());
+	cf_binary_writer_add_section(w, "draw.batches", draw->capture_batches.data(), sizeof(CF_DrawCaptureBatch) * draw->capture_batches.count());
+	cf_binary_writer_add_section(w, "draw.uniforms", draw->capture_uniforms.data(), sizeof(CF_DrawCaptureUniform) * draw->capture_uniforms.count());
+	cf_binary_writer_add_section(w, "draw.uniform_data", draw->capture_uniform_data.data(), draw->capture_uniform_data.count());
+	cf_binary_writer_add_section(w, "draw.vertices", draw->capture_vertices.data(), draw->capture_vertices.count());
+	size_t size = 0;
+	void* data = cf_binary_writer_finish(w, &size);
+	cf_destroy_binary_writer(w);
+	draw->capture_writer = { 0 };
+
+	CF_Result result = cf_fs_write_entire_buffer_to_file(path, data, size);
+	cf_free(data);
+	draw->capture_passes.clear();
+	draw->capture_batches.clear();
+	draw->capture_uniforms.clear();
+	draw->capture_uniform_data.clear();
+	draw->capture_vertices.clear();
+	return result;
+}
+
+struct CF_DrawReplay
+{
+	CF_BinaryReader reader;
+	const CF_DrawCapturePass* passes;
+	int pass_count;
+	const CF_DrawCaptureBatch* batches;
+	int batch_count;
+	const CF_DrawCaptureUniform* uniforms;
+	int uniform_count;
+	const uint8_t* uniform_data;
+	size_t uniform_data_size;
+	const uint8_t* vertices;
+	size_t vertices_size;
+};
+
+// Fetches a section holding an array of `element_size` byte elements.
+static const void* s_replay_section(CF_DrawReplay* replay, const char* name, size_t element_size, int* count)
+{
+	size_t size = 0;
+	const void* section = cf_binary_section(&replay->reader, name, &size);
+	if (!section || size % element_size) return NULL;
+	*count = (int)(size / element_size);
+	return section;
+}
+
+// Largest texture a replay will stand in for, bigger ones only come from corrupt captures.
+#define CF_DRAW_CAPTURE_MAX_TEXTURE_SIZE 16384
+
+static CF_Result s_replay_load(CF_DrawReplay* replay, const void* data, size_t size)
+{
+	CF_Result result = cf_binary_reader_init(&replay->reader, data, size);
+	if (cf_is_error(result)) return result;
+
+	int header_count = 0;
+	const CF_DrawCaptureHeader* header = (const CF_DrawCaptureHeader*)s_replay_section(replay, "draw.header", sizeof(CF_DrawCaptureHeader), &header_count);
+	if (!header || header_count != 1) return cf_result_error("Not a draw capture (missing header).");
+	if (header->version != CF_DRAW_CAPTURE_VERSION) return cf_result_error("Unsupported draw capture version.");
+	bool compatible = header->pass_size == sizeof(CF_DrawCapturePass) && header->batch_size == sizeof(CF_DrawCaptureBatch) && header->uniform_size == sizeof(CF_DrawCaptureUniform);
+	compatible = compatible && !CF_MEMCMP(header->strides, s_capture_strides, sizeof(header->strides));
+	if (!compatible) return cf_result_error("Draw capture was made with an incompatible vertex layout.");
+
+	int uniform_data_size = 0;
+	int vertices_size = 0;
+	replay->passes = (const CF_DrawCapturePass*)s_replay_section(replay, "draw.passes", sizeof(CF_DrawCapturePass), &replay->pass_count);
+	replay->batches = (const CF_DrawCaptureBatch*)s_replay_section(replay, "draw.batches", sizeof(CF_DrawCaptureBatch), &replay->batch_count);
+	replay->uniforms = (const CF_DrawCaptureUniform*)s_replay_section(replay, "draw.uniforms", sizeof(CF_DrawCaptureUniform), &replay->uniform_count);
+	replay->uniform_data = (const uint8_t*)s_replay_section(replay, "draw.uniform_data", 1, &uniform_data_size);
+	replay->vertices = (const uint8_t*)s_replay_section(replay, "draw.vertices", 1, &vertices_size);
+	replay->uniform_data_size = (size_t)uniform_data_size;
+	replay->vertices_size = (size_t)vertices_size;
+	if (!replay->passes || !replay->batches || !replay->uniforms || !replay->uniform_data || !replay->vertices) return cf_result_error("Draw capture is missing a section.");
+
+	// Validate every range up front, so replaying never reads out of bounds.
+	for (int i = 0; i < replay->uniform_count; ++i) {
+		const CF_DrawCaptureUniform& u = replay->uniforms[i];
+		if (u.size < 0 || u.data_offset > replay->uniform_data_size || (uint64_t)u.size > replay->uniform_data_size - u.data_offset) return cf_result_error("Draw capture uniform is out of bounds.");
+	}
+	for (int i = 0; i < replay->pass_count; ++i) {
+		const CF_DrawCapturePass& pass = replay->passes[i];
+		if (pass.canvas_w <= 0 || pass.canvas_h <= 0) return cf_result_error("Draw capture pass has an invalid canvas size.");
+		if (pass.batch_start < 0 || pass.batch_count < 0 || pass.batch_start > replay->batch_count - pass.batch_count) return cf_result_error("Draw capture pass batches are out of bounds.");
+		if (pass.uniform_start < 0 || pass.uniform_count < 0 || pass.uniform_start > replay->uniform_count - pass.uniform_count) return cf_result_error("Draw capture pass uniforms are out of bounds.");
+		for (int j = 0; j < CF_DRAW_CAPTURE_MESH_COUNT; ++j) {
+			uint64_t size = (uint64_t)pass.vertex_count[j] * s_capture_strides[j];
+			if (pass.vertex_count[j] < 0 || pass.vertex_offset[j] > replay->vertices_size || size > replay->vertices_size - pass.vertex_offset[j]) return cf_result_error("Draw capture vertices are out of bounds.");
+		}
+		for (int j = pass.batch_start; j < pass.batch_start + pass.batch_count; ++j) {
+			const CF_DrawCaptureBatch& b = replay->batches[j];
+			if (b.mesh < 0 || b.mesh >= CF_DRAW_CAPTURE_MESH_COUNT) return cf_result_error("Draw capture batch has an invalid mesh.");
+			bool instanced = b.mesh == CF_DRAW_CAPTURE_MESH_INSTANCES;
+			int first = instanced ? b.first_instance : b.first_vertex;
+			int count = instanced ? b.instance_count : b.vertex_count;
+			if (first < 0 || count < 0 || first > pass.vertex_count[b.mesh] - count) return cf_result_error("Draw capture batch vertices are out of bounds.");
+			if (instanced && (b.first_vertex != 0 || b.vertex_count != 4)) return cf_result_error("Draw capture batch vertices are out of bounds.");
+			// Quads and sprites index into the shared quad index buffer, which is only sized for the vertices in the pass.
+			if (b.mesh == CF_DRAW_CAPTURE_MESH_QUADS || b.mesh == CF_DRAW_CAPTURE_MESH_SPRITES) {
+				if (b.index_count < 0 || b.index_count % 6 || b.index_count > b.vertex_count / 4 * 6) return cf_result_error("Draw capture batch indices are out of bounds.");
+			} else if (b.index_count) {
+				return cf_result_error("Draw capture batch indices are out of bounds.");
+			}
+			if (b.texture_w <= 0 || b.texture_h <= 0 || b.texture_w > CF_DRAW_CAPTURE_MAX_TEXTURE_SIZE || b.texture_h > CF_DRAW_CAPTURE_MAX_TEXTURE_SIZE) return cf_result_error("Draw capture batch has an invalid texture size.");
+			if (b.uniform_start < 0 || b.uniform_count < 0 || b.uniform_start > replay->uniform_count - b.uniform_count) return cf_result_error("Draw capture batch uniforms are out of bounds.");
+		}
+	}
+	return cf_result_success();
+}
+
+static void s_replay_uniforms(CF_DrawReplay* replay, int start, int count)
+{
+	for (int i = start; i < start + count; ++i) {
+		const CF_DrawCaptureUniform& u = replay->uniforms[i];
+		const char* name = sintern(cf_binary_string(&replay->reader, u.name));
+		cf_material_set_uniform_fs_internal(draw->material, "shd_uniforms", name, (void*)(replay->uniform_data + u.data_offset), (CF_UniformType)u.type, u.array_length);
+	}
+}
+
+// Replays one `cf_render_to` call. Vertices go back through `s_upload_batches` and the batches through
+// `s_draw_batch`/`s_blit`, so the work done matches the original frame as closely as possible.
+static void s_replay_pass(CF_DrawReplay* replay, const CF_DrawCapturePass& pass, CF_Canvas canvas)
+{
+	CF_ASSERT(!draw->verts.count() && !draw->tri_verts.count() && !draw->sprite_verts.count() && !draw->instances.count() && !draw->blit_verts.count());
+	const uint8_t* verts[CF_DRAW_CAPTURE_MESH_COUNT];
+	for (int i = 0; i < CF_DRAW_CAPTURE_MESH_COUNT; ++i) {
+		verts[i] = replay->vertices + pass.vertex_offset[i];
+		if (i != CF_DRAW_CAPTURE_MESH_BLITS) {
+			draw->stats.vertex_bytes += (uint64_t)pass.vertex_count[i] * s_capture_strides[i];
+		}
+	}
+	draw->tri_verts.ensure_count(pass.vertex_count[CF_DRAW_CAPTURE_MESH_TRIS]);
+	draw->verts.ensure_count(pass.vertex_count[CF_DRAW_CAPTURE_MESH_QUADS]);
+	draw->sprite_verts.ensure_count(pass.vertex_count[CF_DRAW_CAPTURE_MESH_SPRITES]);
+	draw->instances.ensure_count(pass.vertex_count[CF_DRAW_CAPTURE_MESH_INSTANCES]);
+	draw->blit_verts.ensure_count(pass.vertex_count[CF_DRAW_CAPTURE_MESH_BLITS]);
+	void* dst[CF_DRAW_CAPTURE_MESH_COUNT] = { draw->tri_verts.data(), draw->verts.data(), draw->sprite_verts.data(), draw->instances.data(), draw->blit_verts.data() };
+	for (int i = 0; i < CF_DRAW_CAPTURE_MESH_COUNT; ++i) {
+		if (pass.vertex_count[i]) CF_MEMCPY(dst[i], verts[i], (size_t)pass.vertex_count[i] * s_capture_strides[i]);
+	}
+	if (pass.vertex_count[CF_DRAW_CAPTURE_MESH_BLITS]) s_init_blit_mesh();
+	s_ensure_quad_indices(cf_max(pass.vertex_count[CF_DRAW_CAPTURE_MESH_QUADS], pass.vertex_count[CF_DRAW_CAPTURE_MESH_SPRITES]) / 4);
+	s_upload_batches();
+
+	cf_apply_canvas(canvas, pass.clear != 0);
+	for (int i = pass.batch_start; i < pass.batch_start + pass.batch_count; ++i) {
+		const CF_DrawCaptureBatch& b = replay->batches[i];
+		s_replay_uniforms(replay, b.uniform_start, b.uniform_count);
+
+		// Atlases and canvases don't exist anymore, so each texture is stood in for by a blank one of the same size.
+		// These are kept for later replays, so replaying the same capture repeatedly doesn't time texture creation.
+		CF_Texture* texture = draw->replay_textures.try_get(b.texture_id);
+		if (texture) {
+			CF_TextureInternal* internal = (CF_TextureInternal*)texture->id;
+			if (internal->w != b.texture_w || internal->h != b.texture_h) {
+				cf_destroy_texture(*texture);
+				*texture = cf_make_texture(cf_texture_defaults(b.texture_w, b.texture_h));
+			}
+		} else {
+			texture = draw->replay_textures.add(b.texture_id, cf_make_texture(cf_texture_defaults(b.texture_w, b.texture_h)));
+		}
+
+		CF_DrawBatch batch = { };
+		batch.shader = s_capture_shader(b.mesh);
+		batch.mesh = s_capture_mesh(b.mesh);
+		batch.first_vertex = b.first_vertex;
+		batch.vertex_count = b.vertex_count;
+		batch.first_instance = b.first_instance;
+		batch.instance_count = b.instance_count;
+		batch.index_count = b.index_count;
+		batch.texture_id = texture->id;
+		batch.texture_w = b.texture_w;
+		batch.texture_h = b.texture_h;
+		batch.is_blit = b.mesh == CF_DRAW_CAPTURE_MESH_BLITS;
+		CF_Command cmd;
+		cmd.alpha_discard = b.alpha_discard;
+		cmd.viewport = b.viewport;
+		cmd.scissor = b.scissor;
+		cmd.render_state = b.render_state;
+		if (batch.is_blit) {
+			s_blit(batch, cmd);
+		} else {
+			if (b.mesh == CF_DRAW_CAPTURE_MESH_SPRITES) draw->stats.sprite_batch_count++;
+			if (b.mesh == CF_DRAW_CAPTURE_MESH_INSTANCES) draw->stats.instanced_batch_count++;
+			s_draw_batch(batch, cmd);
+		}
+	}
+	s_replay_uniforms(replay, pass.uniform_start, pass.uniform_count);
+	cf_commit();
+
+	if (pass.clear && !pass.batch_count) {
+		cf_clear_canvas(canvas);
+	}
+	draw->verts.clear();
+	draw->tri_verts.clear();
+	draw->sprite_verts.clear();
+	draw->instances.clear();
+	draw->blit_verts.clear();
+}
+
+CF_Result cf_draw_replay_capture(const char* path, CF_Canvas canvas)
+{
+	CF_ASSERT(!draw->recording);
+	size_t size = 0;
+	void* data = cf_fs_read_entire_file_to_memory(path, &size);
+	if (!data) return cf_result_error("Unable to open draw capture.");
+	CF_DEFER(cf_free(data));
+
+	CF_DrawReplay replay = { };
+	CF_Result result = s_replay_load(&replay, data, size);
+	if (cf_is_error(result)) return result;
+
+	// Captured scissors are already split into hardware and per-vertex ones.
+	bool vertex_scissor = draw->vertex_scissor;
+	draw->vertex_scissor = false;
+	for (int i = 0; i < replay.pass_count; ++i) {
+		s_replay_pass(&replay, replay.passes[i], canvas);
+	}
+	draw->vertex_scissor = vertex_scissor;
+	return cf_result_success();
 }
 
 CF_V2 cf_draw_mul(CF_V2 v)
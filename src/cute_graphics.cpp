@@ -25,7 +25,9 @@
 
 struct CF_CanvasInternal;
 static CF_CanvasInternal* s_canvas = NULL;
+static CF_CanvasInternal* s_null_pass = NULL; // Canvas with a pretend render pass open, for the null backend.
 static CF_CanvasInternal* s_default_canvas = NULL;
+static uint64_t s_shader_id = 0;
 
 #include <float.h>
 
@@ -342,6 +344,7 @@ layout (location = 10) in float in_stroke;
 layout (location = 11) in float in_aa;
 layout (location = 12) in vec4 in_params;
 layout (location = 13) in vec4 in_user_params;
+layout (location = 14) in vec4 in_clip;
 
 layout (location = 0) out vec2 v_pos;
 layout (location = 1) out int v_n;
@@ -360,6 +363,11 @@ layout (location = 13) out float v_fill;
 layout (location = 14) out vec2 v_posH;
 layout (location = 15) out vec4 v_user;
 
+out gl_PerVertex {
+	vec4 gl_Position;
+	float gl_ClipDistance[4];
+};
+
 void main()
 {
 	v_pos = in_pos;
@@ -378,10 +386,161 @@ void main()
 	v_fill = in_params.b;
 	// unused = in_params.a;
 
-	vec4 posH = vec4(in_posH, 0, 1);
-	gl_Position = posH;
-	v_posH = in_posH;
+	vec2 posH = in_posH;
+	gl_Position = vec4(posH, 0, 1);
+	v_posH = posH;
 	v_user = in_user_params;
+
+	// Clip against the scissor stored on each vertex, see `cf_draw_set_vertex_scissor`.
+	gl_ClipDistance[0] = posH.x - in_clip.x;
+	gl_ClipDistance[1] = posH.y - in_clip.y;
+	gl_ClipDistance[2] = in_clip.z - posH.x;
+	gl_ClipDistance[3] = in_clip.w - posH.y;
+}
+)";
+
+// Slimmed down vertex shader for batches made up entirely of sprites and text. Only the attributes
+// sprites actually use are sent to the GPU, see `CF_SpriteVertex`. All varyings of `s_draw_vs` are
+// still written so the same fragment shader (including any user `shader` function) can be paired up.
+const char* s_draw_sprite_vs = R"(
+layout (location = 0) in vec2 in_posH;
+layout (location = 1) in vec2 in_uv;
+layout (location = 2) in vec4 in_col;
+layout (location = 3) in vec4 in_params;
+layout (location = 4) in vec4 in_user_params;
+layout (location = 5) in vec4 in_clip;
+
+layout (location = 0) out vec2 v_pos;
+layout (location = 1) out int v_n;
+layout (location = 2) out vec4 v_ab;
+layout (location = 3) out vec4 v_cd;
+layout (location = 4) out vec4 v_ef;
+layout (location = 5) out vec4 v_gh;
+layout (location = 6) out vec2 v_uv;
+layout (location = 7) out vec4 v_col;
+layout (location = 8) out float v_radius;
+layout (location = 9) out float v_stroke;
+layout (location = 10) out float v_aa;
+layout (location = 11) out float v_type;
+layout (location = 12) out float v_alpha;
+layout (location = 13) out float v_fill;
+layout (location = 14) out vec2 v_posH;
+layout (location = 15) out vec4 v_user;
+
+out gl_PerVertex {
+	vec4 gl_Position;
+	float gl_ClipDistance[4];
+};
+
+void main()
+{
+	v_pos = vec2(0);
+	v_n = 0;
+	v_ab = vec4(0);
+	v_cd = vec4(0);
+	v_ef = vec4(0);
+	v_gh = vec4(0);
+	v_uv = in_uv;
+	v_col = in_col;
+	v_radius = 0;
+	v_stroke = 0;
+	v_aa = 0;
+	v_type = in_params.r;
+	v_alpha = in_params.g;
+	v_fill = in_params.b;
+
+	vec2 posH = in_posH;
+	gl_Position = vec4(posH, 0, 1);
+	v_posH = posH;
+	v_user = in_user_params;
+
+	// Clip against the scissor stored on each vertex, see `cf_draw_set_vertex_scissor`.
+	gl_ClipDistance[0] = posH.x - in_clip.x;
+	gl_ClipDistance[1] = posH.y - in_clip.y;
+	gl_ClipDistance[2] = in_clip.z - posH.x;
+	gl_ClipDistance[3] = in_clip.w - posH.y;
+}
+)";
+
+// Instanced vertex shader for SDF shapes and sprites. Each instance is a single shape or sprite, see
+// `CF_DrawInstance`, expanded over a shared unit quad. `in_corner` selects which of the four corners
+// the current vertex sits at. All varyings of `s_draw_vs` are written so `s_draw_fs` can be reused.
+const char* s_draw_instanced_vs = R"(
+layout (location = 0) in float in_corner;
+
+layout (location = 1) in vec4 in_p01;
+layout (location = 2) in vec4 in_p23;
+layout (location = 3) in vec4 in_posH01;
+layout (location = 4) in vec4 in_posH23;
+layout (location = 5) in int in_n;
+layout (location = 6) in vec4 in_ab;
+layout (location = 7) in vec4 in_cd;
+layout (location = 8) in vec4 in_ef;
+layout (location = 9) in vec4 in_gh;
+layout (location = 10) in vec4 in_uv_rect;
+layout (location = 11) in vec4 in_col;
+layout (location = 12) in vec3 in_radius_stroke_aa;
+layout (location = 13) in vec4 in_params;
+layout (location = 14) in vec4 in_user_params;
+layout (location = 15) in vec4 in_clip;
+
+layout (location = 0) out vec2 v_pos;
+layout (location = 1) out int v_n;
+layout (location = 2) out vec4 v_ab;
+layout (location = 3) out vec4 v_cd;
+layout (location = 4) out vec4 v_ef;
+layout (location = 5) out vec4 v_gh;
+layout (location = 6) out vec2 v_uv;
+layout (location = 7) out vec4 v_col;
+layout (location = 8) out float v_radius;
+layout (location = 9) out float v_stroke;
+layout (location = 10) out float v_aa;
+layout (location = 11) out float v_type;
+layout (location = 12) out float v_alpha;
+layout (location = 13) out float v_fill;
+layout (location = 14) out vec2 v_posH;
+layout (location = 15) out vec4 v_user;
+
+out gl_PerVertex {
+	vec4 gl_Position;
+	float gl_ClipDistance[4];
+};
+
+void main()
+{
+	int corner = int(in_corner + 0.5);
+	vec2 p    = corner == 0 ? in_p01.xy    : corner == 1 ? in_p01.zw    : corner == 2 ? in_p23.xy    : in_p23.zw;
+	vec2 posH = corner == 0 ? in_posH01.xy : corner == 1 ? in_posH01.zw : corner == 2 ? in_posH23.xy : in_posH23.zw;
+
+	// Corners wind 0 -> 1 -> 2 -> 3, matching uv's (min,max) -> (max,max) -> (max,min) -> (min,min).
+	vec2 uv;
+	uv.x = (corner == 1 || corner == 2) ? in_uv_rect.z : in_uv_rect.x;
+	uv.y = (corner <= 1) ? in_uv_rect.w : in_uv_rect.y;
+
+	v_pos = p;
+	v_n = in_n;
+	v_ab = in_ab;
+	v_cd = in_cd;
+	v_ef = in_ef;
+	v_gh = in_gh;
+	v_uv = uv;
+	v_col = in_col;
+	v_radius = in_radius_stroke_aa.x;
+	v_stroke = in_radius_stroke_aa.y;
+	v_aa = in_radius_stroke_aa.z;
+	v_type = in_params.r;
+	v_alpha = in_params.g;
+	v_fill = in_params.b;
+
+	gl_Position = vec4(posH, 0, 1);
+	v_posH = posH;
+	v_user = in_user_params;
+
+	// Clip against the scissor stored on each vertex, see `cf_draw_set_vertex_scissor`.
+	gl_ClipDistance[0] = posH.x - in_clip.x;
+	gl_ClipDistance[1] = posH.y - in_clip.y;
+	gl_ClipDistance[2] = in_clip.z - posH.x;
+	gl_ClipDistance[3] = in_clip.w - posH.y;
 }
 )";
 
@@ -579,6 +738,7 @@ struct CF_Buffer
 	int element_count;
 	int size;
 	int stride;
+	int offset; // In bytes, where the buffer is bound. See `cf_mesh_set_draw_range`.
 	SDL_GPUBuffer* buffer;
 	SDL_GPUTransferBuffer* transfer_buffer;
 };
@@ -590,10 +750,68 @@ struct CF_MeshInternal
 	CF_Buffer instances;
 	int attribute_count;
 	CF_VertexAttribute attributes[CF_MESH_MAX_VERTEX_ATTRIBUTES];
+	uint64_t layout_hash; // See `s_hash_mesh_layout`.
 };
 
+// Continues an FNV-1a hash (see `cf_fnv1a`) over more bytes.
+static uint64_t s_hash(uint64_t h, const void* data, int size)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	while (size--) {
+		h = h ^ (uint64_t)(*p++);
+		h = h * 1099511628211ULL;
+	}
+	return h;
+}
+
+// Hashes the vertex layout of a mesh, part of the key pipelines are cached by. Members are hashed one at a time
+// to skip struct padding.
+static void s_hash_mesh_layout(CF_MeshInternal* mesh)
+{
+	uint64_t h = cf_fnv1a(&mesh->vertices.stride, sizeof(mesh->vertices.stride));
+	h = s_hash(h, &mesh->instances.stride, sizeof(mesh->instances.stride));
+	for (int i = 0; i < mesh->attribute_count; ++i) {
+		const CF_VertexAttribute* attr = mesh->attributes + i;
+		h = s_hash(h, &attr->name, sizeof(attr->name)); // Interned.
+		h = s_hash(h, &attr->format, sizeof(attr->format));
+		h = s_hash(h, &attr->offset, sizeof(attr->offset));
+		h = s_hash(h, &attr->per_instance, sizeof(attr->per_instance));
+	}
+	mesh->layout_hash = h;
+}
+
+// Hashes the parts of a render state baked into a pipeline, part of the key pipelines are cached by. The state is
+// copied member by member onto a zeroed struct so padding doesn't affect the hash. The stencil reference is dynamic
+// state (see `cf_apply_stencil_reference`) and the blend pixel format is unused, so both are left out.
+static uint64_t s_hash_render_state(const CF_RenderState* state)
+{
+	CF_RenderState key;
+	CF_MEMSET(&key, 0, sizeof(key));
+	key.cull_mode = state->cull_mode;
+	key.blend.enabled = state->blend.enabled;
+	key.blend.write_R_enabled = state->blend.write_R_enabled;
+	key.blend.write_G_enabled = state->blend.write_G_enabled;
+	key.blend.write_B_enabled = state->blend.write_B_enabled;
+	key.blend.write_A_enabled = state->blend.write_A_enabled;
+	key.blend.rgb_op = state->blend.rgb_op;
+	key.blend.rgb_src_blend_factor = state->blend.rgb_src_blend_factor;
+	key.blend.rgb_dst_blend_factor = state->blend.rgb_dst_blend_factor;
+	key.blend.alpha_op = state->blend.alpha_op;
+	key.blend.alpha_src_blend_factor = state->blend.alpha_src_blend_factor;
+	key.blend.alpha_dst_blend_factor = state->blend.alpha_dst_blend_factor;
+	key.depth_compare = state->depth_compare;
+	key.depth_write_enabled = state->depth_write_enabled;
+	key.stencil.enabled = state->stencil.enabled;
+	key.stencil.read_mask = state->stencil.read_mask;
+	key.stencil.write_mask = state->stencil.write_mask;
+	key.stencil.front = state->stencil.front;
+	key.stencil.back = state->stencil.back;
+	return cf_fnv1a(&key, sizeof(key));
+}
+
 CF_BackendType cf_query_backend()
 {
+	if (app->gfx_null) return CF_BACKEND_TYPE_NULL;
 	SDL_GPUShaderFormat format = SDL_GetGPUShaderFormats(app->device);
 	switch (format) {
 	case SDL_GPU_SHADERFORMAT_INVALID:  return CF_BACKEND_TYPE_INVALID;
@@ -609,6 +827,7 @@ CF_BackendType cf_query_backend()
 
 bool cf_texture_supports_format(CF_PixelFormat format, CF_TextureUsageBits usage)
 {
+	if (app->gfx_null) return true;
 	return SDL_GPUTextureSupportsFormat(
 			app->device,
 			s_wrap(format),
@@ -638,6 +857,18 @@ CF_INLINE bool s_is_depth(CF_PixelFormat format)
 
 CF_Texture cf_make_texture(CF_TextureParams params)
 {
+	if (app->gfx_null) {
+		CF_TextureInternal* tex_internal = CF_NEW(CF_TextureInternal);
+		CF_MEMSET(tex_internal, 0, sizeof(*tex_internal));
+		tex_internal->w = params.width;
+		tex_internal->h = params.height;
+		tex_internal->filter = s_wrap(params.filter);
+		tex_internal->format = s_wrap(params.pixel_format);
+		CF_Texture result;
+		result.id = { (uint64_t)tex_internal };
+		return result;
+	}
+
 	SDL_GPUTextureCreateInfo tex_info = SDL_GPUTextureCreateInfoDefaults(params.width, params.height);
 	tex_info.width = (Uint32)params.width;
 	tex_info.height = (Uint32)params.height;
@@ -691,7 +922,7 @@ CF_Texture cf_make_texture(CF_TextureParams params)
 void cf_destroy_texture(CF_Texture texture_handle)
 {
 	CF_TextureInternal* tex = (CF_TextureInternal*)texture_handle.id;
-	SDL_ReleaseGPUTexture(app->device, tex->tex);
+	if (tex->tex) SDL_ReleaseGPUTexture(app->device, tex->tex);
 	if (tex->sampler) SDL_ReleaseGPUSampler(app->device, tex->sampler);
 	if (tex->buf) SDL_ReleaseGPUTransferBuffer(app->device, tex->buf);
 	CF_FREE(tex);
@@ -710,6 +941,7 @@ static SDL_GPUTextureLocation SDL_GPUTextureLocationDefaults(CF_TextureInternal*
 void cf_texture_update(CF_Texture texture_handle, void* data, int size)
 {
 	CF_TextureInternal* tex = (CF_TextureInternal*)texture_handle.id;
+	if (app->gfx_null) return;
 
 	// Copy bytes over to the driver.
 	SDL_GPUTransferBuffer* buf = tex->buf;
@@ -726,6 +958,8 @@ void cf_texture_update(CF_Texture texture_handle, void* data, int size)
 	SDL_UnmapGPUTransferBuffer(app->device, buf);
 
 	// Tell the driver to upload the bytes to the GPU.
+	// ...Copy passes can't be nested within a render pass, so end any that's still open.
+	cf_commit();
 	SDL_GPUCommandBuffer* cmd = app->cmd ? app->cmd : SDL_AcquireGPUCommandBuffer(app->device);
 	SDL_GPUCopyPass* pass = SDL_BeginGPUCopyPass(cmd);
 	SDL_GPUTextureTransferInfo src;
@@ -960,6 +1194,12 @@ static SDL_GPUShader* s_compile(CF_ShaderInternal* shader_internal, const dyna u
 		afree(inputs);
 	}
 
+	// The null backend keeps the reflection info above for materials, but has no device to create shaders on.
+	if (app->gfx_null) {
+		afree(bytecode);
+		return NULL;
+	}
+
 	// Create the actual shader.
 	SDL_GPUShaderCreateInfo shaderCreateInfo = {};
 	shaderCreateInfo.code = bytecode;
@@ -986,11 +1226,12 @@ CF_Shader cf_make_shader_from_bytecode(const dyna uint8_t* vertex_bytecode, cons
 {
 	CF_ShaderInternal* shader_internal = CF_NEW(CF_ShaderInternal);
 	CF_MEMSET(shader_internal, 0, sizeof(*shader_internal));
+	shader_internal->id = ++s_shader_id;
 
 	shader_internal->vs = s_compile(shader_internal, vertex_bytecode, CF_SHADER_STAGE_VERTEX);
 	shader_internal->fs = s_compile(shader_internal, fragment_bytecode, CF_SHADER_STAGE_FRAGMENT);
-	CF_ASSERT(shader_internal->vs);
-	CF_ASSERT(shader_internal->fs);
+	CF_ASSERT(app->gfx_null || shader_internal->vs);
+	CF_ASSERT(app->gfx_null || shader_internal->fs);
 
 	CF_Shader result;
 	result.id = { (uint64_t)shader_internal };
@@ -1153,6 +1394,8 @@ void cf_load_internal_shaders()
 
 	// Compile built-in shaders.
 	app->draw_shader = s_compile(s_draw_vs, s_draw_fs, true, NULL);
+	app->draw_sprite_shader = s_compile(s_draw_sprite_vs, s_draw_fs, true, NULL);
+	app->draw_instanced_shader = s_compile(s_draw_instanced_vs, s_draw_fs, true, NULL);
 	app->basic_shader = s_compile(s_basic_vs, s_basic_fs, true, NULL);
 	app->backbuffer_shader = s_compile(s_backbuffer_vs, s_backbuffer_fs, true, NULL);
 	app->blit_shader = s_compile(s_blit_vs, s_blit_fs, true, NULL);
@@ -1182,6 +1425,34 @@ CF_Shader cf_make_draw_shader_internal(const char* path)
 	return result;
 }
 
+// Create a user shader by injecting their `shader` function into CF's sprite-only draw shader.
+CF_Shader cf_make_draw_sprite_shader_internal(const char* path)
+{
+	Path p = Path("/") + path;
+	const char* path_s = sintern(p);
+	CF_ShaderFileInfo info = app->shader_file_infos.find(path_s);
+	if (!info.path) return { 0 };
+	char* shd = fs_read_entire_file_to_memory_and_nul_terminate(info.path);
+	if (!shd) return { 0 };
+	CF_Shader result = cf_make_draw_sprite_shader_from_source_internal(shd);
+	cf_free(shd);
+	return result;
+}
+
+// Create a user shader by injecting their `shader` function into CF's instanced draw shader.
+CF_Shader cf_make_draw_instanced_shader_internal(const char* path)
+{
+	Path p = Path("/") + path;
+	const char* path_s = sintern(p);
+	CF_ShaderFileInfo info = app->shader_file_infos.find(path_s);
+	if (!info.path) return { 0 };
+	char* shd = fs_read_entire_file_to_memory_and_nul_terminate(info.path);
+	if (!shd) return { 0 };
+	CF_Shader result = cf_make_draw_instanced_shader_from_source_internal(shd);
+	cf_free(shd);
+	return result;
+}
+
 // Create a user shader by injecting their `shader` function into CF's draw shader.
 CF_Shader cf_make_draw_blit_shader_internal(const char* path)
 {
@@ -1201,6 +1472,16 @@ CF_Shader cf_make_draw_shader_from_source_internal(const char* src)
 	return s_compile(s_draw_vs, s_draw_fs, true, src);
 }
 
+CF_Shader cf_make_draw_sprite_shader_from_source_internal(const char* src)
+{
+	return s_compile(s_draw_sprite_vs, s_draw_fs, true, src);
+}
+
+CF_Shader cf_make_draw_instanced_shader_from_source_internal(const char* src)
+{
+	return s_compile(s_draw_instanced_vs, s_draw_fs, true, src);
+}
+
 CF_Shader cf_make_draw_blit_shader_from_source_internal(const char* src)
 {
 	return s_compile(s_blit_vs, s_blit_fs, true, src);
@@ -1229,12 +1510,23 @@ void cf_destroy_shader(CF_Shader shader_handle)
 	if (blit) {
 		cf_destroy_shader(*blit);
 	}
+	CF_Shader* sprite = (CF_Shader*)draw->draw_shd_to_sprite_shd.try_get(shader_handle.id);
+	if (sprite) {
+		cf_destroy_shader(*sprite);
+		draw->draw_shd_to_sprite_shd.remove(shader_handle.id);
+	}
+	CF_Shader* instanced = (CF_Shader*)draw->draw_shd_to_instanced_shd.try_get(shader_handle.id);
+	if (instanced) {
+		cf_destroy_shader(*instanced);
+		draw->draw_shd_to_instanced_shd.remove(shader_handle.id);
+	}
 
 	CF_ShaderInternal* shd = (CF_ShaderInternal*)shader_handle.id;
-	SDL_ReleaseGPUShader(app->device, shd->vs);
-	SDL_ReleaseGPUShader(app->device, shd->fs);
+	if (shd->vs) SDL_ReleaseGPUShader(app->device, shd->vs);
+	if (shd->fs) SDL_ReleaseGPUShader(app->device, shd->fs);
+	CF_CachedPipeline* pips = shd->pip_cache.items();
 	for (int i = 0; i < shd->pip_cache.count(); ++i) {
-		SDL_ReleaseGPUGraphicsPipeline(app->device, shd->pip_cache[i].pip);
+		SDL_ReleaseGPUGraphicsPipeline(app->device, pips[i].pip);
 	}
 	shd->~CF_ShaderInternal();
 	CF_FREE(shd);
@@ -1243,6 +1535,12 @@ void cf_destroy_shader(CF_Shader shader_handle)
 void cf_clear_canvas(CF_Canvas canvas_handle)
 {
 	CF_CanvasInternal* canvas = (CF_CanvasInternal*)canvas_handle.id;
+	cf_commit();
+	if (app->gfx_null) {
+		app->render_pass_count++;
+		canvas->clear = false;
+		return;
+	}
 	SDL_GPUCommandBuffer* cmd = app->cmd ? app->cmd : SDL_AcquireGPUCommandBuffer(app->device);
 
 	SDL_GPUColorTargetInfo color_info = {
@@ -1262,6 +1560,7 @@ void cf_clear_canvas(CF_Canvas canvas_handle)
 	};
 	SDL_GPURenderPass* renderPass = SDL_BeginGPURenderPass(cmd, &color_info, 1, canvas->depth_stencil ? &depth_stencil_info : NULL);
 	SDL_EndGPURenderPass(renderPass);
+	app->render_pass_count++;
 	canvas->clear = false;
 
 	if (!app->cmd) SDL_SubmitGPUCommandBuffer(cmd);
@@ -1319,8 +1618,15 @@ CF_Canvas cf_make_canvas(CF_CanvasParams params)
 void cf_destroy_canvas(CF_Canvas canvas_handle)
 {
 	CF_CanvasInternal* canvas = (CF_CanvasInternal*)canvas_handle.id;
+	if (s_canvas == canvas) {
+		cf_commit();
+		s_canvas = NULL;
+	}
+	if (canvas->premade_registered && draw) {
+		spritebatch_unregister_premade_sprite(&draw->sb, CF_CANVAS_ID_RANGE_LO + canvas_handle.id);
+	}
 	cf_destroy_texture(canvas->cf_texture);
-	if (canvas->depth_stencil) cf_destroy_texture(canvas->cf_depth_stencil);
+	if (canvas->cf_depth_stencil.id) cf_destroy_texture(canvas->cf_depth_stencil);
 	CF_FREE(canvas);
 }
 
@@ -1340,7 +1646,7 @@ CF_Mesh cf_make_mesh(int vertex_buffer_size, const CF_VertexAttribute* attribute
 {
 	CF_MeshInternal* mesh = (CF_MeshInternal*)CF_CALLOC(sizeof(CF_MeshInternal));
 	mesh->vertices.size = vertex_buffer_size;
-	if (vertex_buffer_size) {
+	if (vertex_buffer_size && !app->gfx_null) {
 		SDL_GPUBufferCreateInfo buf_info = {
 			.usage = SDL_GPU_BUFFERUSAGE_VERTEX,
 			.size = (Uint32)vertex_buffer_size,
@@ -1361,6 +1667,7 @@ CF_Mesh cf_make_mesh(int vertex_buffer_size, const CF_VertexAttribute* attribute
 		mesh->attributes[i] = attributes[i];
 		mesh->attributes[i].name = sintern(attributes[i].name);
 	}
+	s_hash_mesh_layout(mesh);
 	CF_Mesh result = { (uint64_t)mesh };
 	return result;
 }
@@ -1369,8 +1676,14 @@ void cf_mesh_set_index_buffer(CF_Mesh mesh_handle, int index_buffer_size_in_byte
 {
 	CF_ASSERT(index_bit_count == 16 || index_bit_count == 32);
 	CF_MeshInternal* mesh = (CF_MeshInternal*)mesh_handle.id;
+	if (mesh->indices.buffer) {
+		SDL_ReleaseGPUBuffer(app->device, mesh->indices.buffer);
+		SDL_ReleaseGPUTransferBuffer(app->device, mesh->indices.transfer_buffer);
+	}
+	mesh->indices.element_count = 0;
 	mesh->indices.size = index_buffer_size_in_bytes;
 	mesh->indices.stride = index_bit_count / 8;
+	if (app->gfx_null) return;
 	SDL_GPUBufferCreateInfo buf_info = {
 		.usage = SDL_GPU_BUFFERUSAGE_INDEX,
 		.size = (Uint32)index_buffer_size_in_bytes,
@@ -1390,6 +1703,10 @@ void cf_mesh_set_instance_buffer(CF_Mesh mesh_handle, int instance_buffer_size_i
 	CF_MeshInternal* mesh = (CF_MeshInternal*)mesh_handle.id;
 	mesh->instances.size = instance_buffer_size_in_bytes;
 	mesh->instances.stride = instance_stride;
+	if (app->gfx_null) {
+		s_hash_mesh_layout(mesh);
+		return;
+	}
 	SDL_GPUBufferCreateInfo buf_info = {
 		.usage = SDL_GPU_BUFFERUSAGE_VERTEX,
 		.size = (Uint32)instance_buffer_size_in_bytes,
@@ -1402,6 +1719,7 @@ void cf_mesh_set_instance_buffer(CF_Mesh mesh_handle, int instance_buffer_size_i
 		.props = 0,
 	};
 	mesh->instances.transfer_buffer = SDL_CreateGPUTransferBuffer(app->device, &tbuf_info);
+	s_hash_mesh_layout(mesh);
 }
 
 void cf_destroy_mesh(CF_Mesh mesh_handle)
@@ -1424,6 +1742,14 @@ void cf_destroy_mesh(CF_Mesh mesh_handle)
 
 static void s_update_buffer(CF_Buffer* buffer, int element_count, void* data, int size, SDL_GPUBufferUsageFlags flags)
 {
+	// The null backend only tracks sizes and counts, the data itself is dropped.
+	if (app->gfx_null) {
+		if (size > buffer->size) buffer->size = size * 2;
+		buffer->element_count = element_count;
+		buffer->offset = 0;
+		return;
+	}
+
 	// Resize buffer if necessary.
 	if (size > buffer->size) {
 		SDL_ReleaseGPUBuffer(app->device, buffer->buffer);
@@ -1446,11 +1772,14 @@ static void s_update_buffer(CF_Buffer* buffer, int element_count, void* data, in
 	}
 
 	// Copy vertices over to the driver.
+	// ...Copy passes can't be nested within a render pass, so end any that's still open.
 	CF_ASSERT(size <= buffer->size);
+	cf_commit();
 	void* p = SDL_MapGPUTransferBuffer(app->device, buffer->transfer_buffer, true);
 	CF_MEMCPY(p, data, size);
 	SDL_UnmapGPUTransferBuffer(app->device, buffer->transfer_buffer);
 	buffer->element_count = element_count;
+	buffer->offset = 0;
 
 	// Submit the upload command to the GPU.
 	SDL_GPUCommandBuffer* cmd = app->cmd ? app->cmd : SDL_AcquireGPUCommandBuffer(app->device);
@@ -1486,6 +1815,24 @@ void cf_mesh_update_instance_data(CF_Mesh mesh_handle, void* data, int count)
 	s_update_buffer(&mesh->instances, count, data, count * mesh->instances.stride, SDL_GPU_BUFFERUSAGE_VERTEX);
 }
 
+void cf_mesh_set_index_count(CF_Mesh mesh_handle, int count)
+{
+	CF_MeshInternal* mesh = (CF_MeshInternal*)mesh_handle.id;
+	CF_ASSERT(count * mesh->indices.stride <= mesh->indices.size);
+	mesh->indices.element_count = count;
+}
+
+void cf_mesh_set_draw_range(CF_Mesh mesh_handle, int first_vertex, int vertex_count, int first_instance, int instance_count)
+{
+	CF_MeshInternal* mesh = (CF_MeshInternal*)mesh_handle.id;
+	CF_ASSERT((first_vertex + vertex_count) * mesh->vertices.stride <= mesh->vertices.size);
+	CF_ASSERT((first_instance + instance_count) * mesh->instances.stride <= mesh->instances.size);
+	mesh->vertices.offset = first_vertex * mesh->vertices.stride;
+	mesh->vertices.element_count = vertex_count;
+	mesh->instances.offset = first_instance * mesh->instances.stride;
+	mesh->instances.element_count = instance_count;
+}
+
 CF_RenderState cf_render_state_defaults()
 {
 	CF_RenderState state;
@@ -1519,12 +1866,32 @@ CF_RenderState cf_render_state_defaults()
 	return state;
 }
 
+static void s_destroy_uniform_plan(CF_UniformPlan* plan)
+{
+	for (int i = 0; i < CF_MAX_UNIFORM_BLOCK_COUNT; ++i) {
+		if (plan->blocks[i]) cf_free(plan->blocks[i]);
+	}
+	plan->~CF_UniformPlan();
+	CF_FREE(plan);
+}
+
+// Frees the uniform plans of a material, they're rebuilt on next use. Plans for shaders destroyed in the
+// meantime go away here as well.
+static void s_clear_uniform_plans(CF_MaterialState* state)
+{
+	CF_UniformPlan** plans = state->plans.items();
+	for (int i = 0; i < state->plans.count(); ++i) {
+		s_destroy_uniform_plan(plans[i]);
+	}
+	state->plans.clear();
+}
+
 CF_Material cf_make_material()
 {
 	CF_MaterialInternal* material = CF_NEW(CF_MaterialInternal);
 	cf_arena_init(&material->uniform_arena, 4, 1024);
-	cf_arena_init(&material->block_arena, 4, 1024);
 	material->state = cf_render_state_defaults();
+	material->state_hash = s_hash_render_state(&material->state);
 	CF_Material result = { (uint64_t)material };
 	return result;
 }
@@ -1532,8 +1899,9 @@ CF_Material cf_make_material()
 void cf_destroy_material(CF_Material material_handle)
 {
 	CF_MaterialInternal* material = (CF_MaterialInternal*)material_handle.id;
+	s_clear_uniform_plans(&material->vs);
+	s_clear_uniform_plans(&material->fs);
 	cf_arena_reset(&material->uniform_arena);
-	cf_arena_reset(&material->block_arena);
 	material->~CF_MaterialInternal();
 	CF_FREE(material);
 }
@@ -1543,7 +1911,7 @@ void cf_material_set_render_state(CF_Material material_handle, CF_RenderState re
 	CF_MaterialInternal* material = (CF_MaterialInternal*)material_handle.id;
 	if (CF_MEMCMP(&material->state, &render_state, sizeof(material->state))) {
 		material->state = render_state;
-		material->dirty = true;
+		material->state_hash = s_hash_render_state(&render_state);
 	}
 }
 
@@ -1562,7 +1930,6 @@ static void s_material_set_texture(CF_MaterialInternal* material, CF_MaterialSta
 		tex.name = name;
 		tex.handle = texture;
 		state->textures.add(tex);
-		material->dirty = true;
 	}
 }
 
@@ -1585,7 +1952,6 @@ void cf_material_clear_textures(CF_Material material_handle)
 	CF_MaterialInternal* material = (CF_MaterialInternal*)material_handle.id;
 	material->vs.textures.clear();
 	material->fs.textures.clear();
-	material->dirty = true;
 }
 
 static void s_material_set_uniform(CF_Arena* arena, CF_MaterialState* state, const char* block_name, const char* name, void* data, CF_UniformType type, int array_length)
@@ -1601,6 +1967,7 @@ static void s_material_set_uniform(CF_Arena* arena, CF_MaterialState* state, con
 	}
 	int size = s_uniform_size(type) * array_length;
 	if (!uniform) {
+		s_clear_uniform_plans(state);
 		uniform = &state->uniforms.add();
 		uniform->name = name;
 		uniform->block_name = block_name;
@@ -1608,10 +1975,14 @@ static void s_material_set_uniform(CF_Arena* arena, CF_MaterialState* state, con
 		uniform->size = size;
 		uniform->type = type;
 		uniform->array_length = array_length;
+		CF_MEMCPY(uniform->data, data, size);
 	}
 	CF_ASSERT(uniform->type == type);
 	CF_ASSERT(uniform->array_length == array_length);
-	CF_MEMCPY(uniform->data, data, size);
+	if (CF_MEMCMP(uniform->data, data, size)) {
+		CF_MEMCPY(uniform->data, data, size);
+		state->version++;
+	}
 }
 
 void cf_material_set_uniform_vs(CF_Material material_handle, const char* name, void* data, CF_UniformType type, int array_length)
@@ -1648,6 +2019,8 @@ void cf_material_clear_uniforms(CF_Material material_handle)
 	arena_reset(&material->uniform_arena);
 	material->vs.uniforms.clear();
 	material->fs.uniforms.clear();
+	s_clear_uniform_plans(&material->vs);
+	s_clear_uniform_plans(&material->fs);
 }
 
 void cf_clear_color(float red, float green, float blue, float alpha)
@@ -1665,6 +2038,10 @@ void cf_apply_canvas(CF_Canvas canvas_handle, bool clear)
 {
 	CF_CanvasInternal* canvas = (CF_CanvasInternal*)canvas_handle.id;
 	CF_ASSERT(canvas);
+	// Keep drawing within the open render pass, unless switching targets or a clear is requested.
+	if (s_canvas != canvas || clear) {
+		cf_commit();
+	}
 	s_canvas = canvas;
 	s_canvas->clear = clear;
 }
@@ -1672,6 +2049,7 @@ void cf_apply_canvas(CF_Canvas canvas_handle, bool clear)
 void cf_apply_viewport(int x, int y, int w, int h)
 {
 	CF_ASSERT(s_canvas);
+	if (app->gfx_null) return;
 	CF_ASSERT(s_canvas->pass);
 	SDL_GPUViewport viewport;
 	viewport.x = (float)x;
@@ -1686,6 +2064,7 @@ void cf_apply_viewport(int x, int y, int w, int h)
 void cf_apply_scissor(int x, int y, int w, int h)
 {
 	CF_ASSERT(s_canvas);
+	if (app->gfx_null) return;
 	CF_ASSERT(s_canvas->pass);
 	SDL_Rect scissor;
 	scissor.x = x;
@@ -1698,6 +2077,7 @@ void cf_apply_scissor(int x, int y, int w, int h)
 void cf_apply_stencil_reference(int reference)
 {
   CF_ASSERT(s_canvas);
+  if (app->gfx_null) return;
   CF_ASSERT(s_canvas->pass);
   SDL_SetGPUStencilReference(s_canvas->pass, reference);
 }
@@ -1705,6 +2085,7 @@ void cf_apply_stencil_reference(int reference)
 void cf_apply_blend_constants(float r, float g, float b, float a)
 {
   CF_ASSERT(s_canvas);
+  if (app->gfx_null) return;
   CF_ASSERT(s_canvas->pass);
   SDL_FColor color;
   color.r = r;
@@ -1721,40 +2102,64 @@ void cf_apply_mesh(CF_Mesh mesh_handle)
 	s_canvas->mesh = mesh;
 }
 
-static void s_copy_uniforms(SDL_GPUCommandBuffer* cmd, CF_Arena* arena, CF_ShaderInternal* shd, CF_MaterialState* mstate, bool vs)
+static CF_UniformPlan* s_build_uniform_plan(CF_ShaderInternal* shd, CF_MaterialState* mstate, bool vs)
 {
-	// Create any required uniform blocks for all uniforms matching between which uniforms
-	// the material has and the shader needs.
-	void* ub_ptrs[CF_MAX_UNIFORM_BLOCK_COUNT] = { };
-	int ub_sizes[CF_MAX_UNIFORM_BLOCK_COUNT] = { };
+	CF_UniformPlan* plan = CF_NEW(CF_UniformPlan);
 	for (int block_index = 0; block_index < shd->uniform_block_count; ++block_index) {
 		for (int i = 0; i < mstate->uniforms.count(); ++i) {
 			CF_Uniform uniform = mstate->uniforms[i];
 			int idx = vs ? shd->vs_index(uniform.name, block_index) : shd->fs_index(uniform.name, block_index);
 			if (idx >= 0) {
-				if (!ub_ptrs[block_index]) {
-					// Create temporary space for a uniform block.
+				if (!plan->blocks[block_index]) {
+					// Create persistent space for a uniform block. Anything the material doesn't set stays zero.
 					int size = vs ? shd->vs_block_sizes[block_index] : shd->fs_block_sizes[block_index];
-					void* block = cf_arena_alloc(arena, size);
+					void* block = cf_alloc(size);
 					CF_MEMSET(block, 0, size);
-					ub_ptrs[block_index] = block;
-					ub_sizes[block_index] = size;
+					plan->blocks[block_index] = block;
+					plan->block_sizes[block_index] = size;
 				}
+				CF_UniformBinding binding;
+				binding.uniform_index = i;
+				binding.offset = vs ? shd->vs_uniform_block_members[block_index][idx].offset : shd->fs_uniform_block_members[block_index][idx].offset;
+				binding.size = uniform.size;
+				plan->bindings[block_index].add(binding);
+			}
+		}
+	}
+	plan->version = mstate->version - 1; // Fill the blocks on first use.
+	return plan;
+}
+
+static void s_copy_uniforms(SDL_GPUCommandBuffer* cmd, CF_ShaderInternal* shd, CF_MaterialState* mstate, bool vs)
+{
+	if (!mstate->uniforms.count()) return;
+
+	// Fetch the precomputed mapping of the material's uniforms onto the shader's uniform blocks.
+	CF_UniformPlan** cached = mstate->plans.try_get(shd->id);
+	CF_UniformPlan* plan = cached ? *cached : NULL;
+	if (!plan) {
+		plan = s_build_uniform_plan(shd, mstate, vs);
+		mstate->plans.add(shd->id, plan);
+	}
 
-				// Copy in the uniform's value into the block.
-				int offset = vs ? shd->vs_uniform_block_members[block_index][idx].offset : shd->fs_uniform_block_members[block_index][idx].offset;
-				void* block = ub_ptrs[block_index];
-				void* dst = (void*)(((uintptr_t)block) + offset);
-				CF_MEMCPY(dst, uniform.data, uniform.size);
+	// Copy uniform values into the blocks, but only if any have changed since last time.
+	if (plan->version != mstate->version) {
+		plan->version = mstate->version;
+		for (int block_index = 0; block_index < CF_MAX_UNIFORM_BLOCK_COUNT; ++block_index) {
+			const Array<CF_UniformBinding>& bindings = plan->bindings[block_index];
+			for (int i = 0; i < bindings.count(); ++i) {
+				CF_UniformBinding binding = bindings[i];
+				void* dst = (void*)(((uintptr_t)plan->blocks[block_index]) + binding.offset);
+				CF_MEMCPY(dst, mstate->uniforms[binding.uniform_index].data, binding.size);
 			}
 		}
 	}
 
 	// Send uniform data to the GPU.
 	for (int i = 0; i < CF_MAX_UNIFORM_BLOCK_COUNT; ++i) {
-		if (ub_ptrs[i]) {
-			void* block = ub_ptrs[i];
-			int size = ub_sizes[i];
+		if (plan->blocks[i]) {
+			void* block = plan->blocks[i];
+			int size = plan->block_sizes[i];
 			if (vs) {
 				SDL_PushGPUVertexUniformData(cmd, i, block, (uint32_t)size);
 			} else {
@@ -1762,9 +2167,6 @@ static void s_copy_uniforms(SDL_GPUCommandBuffer* cmd, CF_Arena* arena, CF_Shade
 			}
 		}
 	}
-
-	// @TODO Use a different allocation scheme that caches better.
-	cf_arena_reset(arena);
 }
 
 static SDL_GPUGraphicsPipeline* s_build_pipeline(CF_ShaderInternal* shader, CF_RenderState* state, CF_MeshInternal* mesh)
@@ -1883,64 +2285,88 @@ void cf_apply_shader(CF_Shader shader_handle, CF_Material material_handle)
 	CF_ShaderInternal* shader = (CF_ShaderInternal*)shader_handle.id;
 	CF_RenderState* state = &material->state;
 
-	// Cache the pipeline to avoid create/release each frame.
-	// ...Build a new one if the material marks itself as dirty.
-	SDL_GPUGraphicsPipeline* pip = NULL;
-	bool found = false;
-	for (int i = 0; i < shader->pip_cache.count(); ++i) {
-		CF_Pipeline pip_cache = shader->pip_cache[i];
-		if (pip_cache.material == material && pip_cache.mesh == mesh) {
-			found = true;
-			if (material->dirty) {
-				material->dirty = false;
-				pip = s_build_pipeline(shader, state, mesh);
-				if (pip_cache.pip) {
-					SDL_ReleaseGPUGraphicsPipeline(app->device, pip_cache.pip);
-				}
-				shader->pip_cache[i].pip = pip;
-			} else {
-				pip = pip_cache.pip;
-			}
+	// The null backend opens a pretend render pass, so pass counts match a real backend.
+	if (app->gfx_null) {
+		if (s_null_pass != s_canvas) {
+			s_null_pass = s_canvas;
+			app->render_pass_count++;
 		}
+		s_canvas->clear = false;
+		return;
 	}
-	if (!found) {
-		pip = s_build_pipeline(shader, state, mesh);
-		shader->pip_cache.add({ material, pip, mesh });
+
+	// Cache pipelines to avoid create/release each frame. They're keyed by everything baked into them, so any
+	// material with an equivalent render state shares the same pipeline, and switching back and forth between
+	// render states never rebuilds one. The map is indexed by a hash of the key, so the full key is compared on a
+	// hit, and on the rare collision the old pipeline is replaced.
+	CF_TextureInternal* depth_stencil = (CF_TextureInternal*)s_canvas->cf_depth_stencil.id;
+	uint64_t key[CF_PIPELINE_KEY_COUNT] = {
+		material->state_hash,
+		mesh->layout_hash,
+		(uint64_t)(mesh->vertices.buffer ? 1 : 0) | (uint64_t)(mesh->instances.buffer ? 2 : 0),
+		(uint64_t)((CF_TextureInternal*)s_canvas->cf_texture.id)->format,
+		(uint64_t)(depth_stencil ? depth_stencil->format + 1 : 0),
+	};
+	uint64_t pip_key = cf_fnv1a(key, sizeof(key));
+	CF_CachedPipeline* cached = shader->pip_cache.try_get(pip_key);
+	if (cached && CF_MEMCMP(cached->key, key, sizeof(key))) {
+		SDL_ReleaseGPUGraphicsPipeline(app->device, cached->pip);
+		cached->pip = NULL;
+	}
+	if (!cached) {
+		CF_CachedPipeline entry = { };
+		cached = shader->pip_cache.add(pip_key, entry);
+	}
+	if (!cached->pip) {
+		CF_MEMCPY(cached->key, key, sizeof(key));
+		cached->pip = s_build_pipeline(shader, state, mesh);
 	}
+	SDL_GPUGraphicsPipeline* pip = cached->pip;
 	CF_ASSERT(pip);
 
 	SDL_GPUCommandBuffer* cmd = app->cmd;
 	CF_ASSERT(cmd);
 	s_canvas->pip = pip;
 
-	SDL_GPUColorTargetInfo pass_color_info;
-	CF_MEMSET(&pass_color_info, 0, sizeof(pass_color_info));
-	pass_color_info.texture = s_canvas->texture;
-	pass_color_info.clear_color = { app->clear_color.r, app->clear_color.g, app->clear_color.b, app->clear_color.a };
-	pass_color_info.load_op = s_canvas->clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
-	pass_color_info.store_op = SDL_GPU_STOREOP_STORE;
-	pass_color_info.cycle = s_canvas->clear ? true : false;
-	SDL_GPUDepthStencilTargetInfo pass_depth_stencil_info;
-	CF_MEMSET(&pass_depth_stencil_info, 0, sizeof(pass_depth_stencil_info));
-	pass_depth_stencil_info.texture = s_canvas->depth_stencil;
-	if (s_canvas->depth_stencil) {
-		pass_depth_stencil_info.clear_depth = app->clear_depth;
-		pass_depth_stencil_info.clear_stencil = app->clear_stencil;
-		pass_depth_stencil_info.load_op = s_canvas->clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
-		pass_depth_stencil_info.store_op = SDL_GPU_STOREOP_STORE;
-		pass_depth_stencil_info.stencil_load_op = s_canvas->clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
-		pass_depth_stencil_info.stencil_store_op = SDL_GPU_STOREOP_DONT_CARE;
-		pass_depth_stencil_info.cycle = pass_color_info.cycle;
-	}
-	SDL_GPURenderPass* pass = SDL_BeginGPURenderPass(cmd, &pass_color_info, 1, s_canvas->depth_stencil ? &pass_depth_stencil_info : NULL);
-	CF_ASSERT(pass);
-	s_canvas->pass = pass;
+	// Consecutive draws onto the same canvas share a single render pass, which stays open until `cf_commit`.
+	SDL_GPURenderPass* pass = s_canvas->pass;
+	if (!pass) {
+		SDL_GPUColorTargetInfo pass_color_info;
+		CF_MEMSET(&pass_color_info, 0, sizeof(pass_color_info));
+		pass_color_info.texture = s_canvas->texture;
+		pass_color_info.clear_color = { app->clear_color.r, app->clear_color.g, app->clear_color.b, app->clear_color.a };
+		pass_color_info.load_op = s_canvas->clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
+		pass_color_info.store_op = SDL_GPU_STOREOP_STORE;
+		pass_color_info.cycle = s_canvas->clear ? true : false;
+		SDL_GPUDepthStencilTargetInfo pass_depth_stencil_info;
+		CF_MEMSET(&pass_depth_stencil_info, 0, sizeof(pass_depth_stencil_info));
+		pass_depth_stencil_info.texture = s_canvas->depth_stencil;
+		if (s_canvas->depth_stencil) {
+			pass_depth_stencil_info.clear_depth = app->clear_depth;
+			pass_depth_stencil_info.clear_stencil = app->clear_stencil;
+			pass_depth_stencil_info.load_op = s_canvas->clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
+			pass_depth_stencil_info.store_op = SDL_GPU_STOREOP_STORE;
+			pass_depth_stencil_info.stencil_load_op = s_canvas->clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
+			pass_depth_stencil_info.stencil_store_op = SDL_GPU_STOREOP_DONT_CARE;
+			pass_depth_stencil_info.cycle = pass_color_info.cycle;
+		}
+		pass = SDL_BeginGPURenderPass(cmd, &pass_color_info, 1, s_canvas->depth_stencil ? &pass_depth_stencil_info : NULL);
+		CF_ASSERT(pass);
+		s_canvas->pass = pass;
+		app->render_pass_count++;
+	} else {
+		// Reset the viewport and scissor, as a freshly opened pass would.
+		SDL_GPUViewport viewport = { 0, 0, (float)s_canvas->w, (float)s_canvas->h, 0, 1 };
+		SDL_SetGPUViewport(pass, &viewport);
+		SDL_Rect scissor = { 0, 0, s_canvas->w, s_canvas->h };
+		SDL_SetGPUScissor(pass, &scissor);
+	}
 	SDL_BindGPUGraphicsPipeline(pass, pip);
 	SDL_GPUBufferBinding bind[2];
 	bind[0].buffer = mesh->vertices.buffer;
-	bind[0].offset = 0;
+	bind[0].offset = (Uint32)mesh->vertices.offset;
 	bind[1].buffer = mesh->instances.buffer;
-	bind[1].offset = 0;
+	bind[1].offset = (Uint32)mesh->instances.offset;
 	SDL_BindGPUVertexBuffers(pass, 0, bind, mesh->instances.buffer ? 2 : 1);
 
 	if (mesh->indices.buffer) {
@@ -1970,8 +2396,8 @@ void cf_apply_shader(CF_Shader shader_handle, CF_Material material_handle)
 	SDL_BindGPUFragmentSamplers(pass, 0, sampler_bindings, (Uint32)found_image_count);
 
 	// Copy over uniform data.
-	s_copy_uniforms(cmd, &material->block_arena, shader, &material->vs, true);
-	s_copy_uniforms(cmd, &material->block_arena, shader, &material->fs, false);
+	s_copy_uniforms(cmd, shader, &material->vs, true);
+	s_copy_uniforms(cmd, shader, &material->fs, false);
 
 	SDL_SetGPUStencilReference(pass, state->stencil.reference);
 
@@ -1981,6 +2407,10 @@ void cf_apply_shader(CF_Shader shader_handle, CF_Material material_handle)
 
 void cf_draw_elements()
 {
+	if (app->gfx_null) {
+		app->draw_call_count++;
+		return;
+	}
 	CF_MeshInternal* mesh = s_canvas->mesh;
 	if (mesh->instances.buffer) {
 		if (mesh->indices.buffer) {
@@ -2000,7 +2430,11 @@ void cf_draw_elements()
 
 void cf_commit()
 {
-	SDL_EndGPURenderPass(s_canvas->pass);
+	s_null_pass = NULL;
+	if (s_canvas && s_canvas->pass) {
+		SDL_EndGPURenderPass(s_canvas->pass);
+		s_canvas->pass = NULL;
+	}
 }
 
 #include <SPIRV-Reflect/spirv_reflect.c>
@@ -14,6 +14,19 @@
 
 #include <internal/cute_alloc_internal.h>
 #include <internal/cute_app_internal.h>
+#include <internal/cute_simd_internal.h>
+
+#include <charconv>
+#include <errno.h>
+#include <float.h>
+#include <locale.h>
+#include <math.h>
+
+// Floating-point `to_chars`/`from_chars` are missing from some standard libraries, notably Apple's libc++, where they're
+// either unimplemented or need a recent deployment target. Those fall back to the C runtime for floats and doubles.
+#if defined(__cpp_lib_to_chars) && !defined(__APPLE__)
+#	define CF_FLOAT_CHARCONV
+#endif
 
 using namespace Cute;
 
@@ -335,6 +348,142 @@ uint64_t cf_stohex(const char* s)
 	return len == 6 ? ((result << 16) | 0xFF) : result;
 }
 
+// Enough room for any int64_t/uint64_t, or the shortest round-trip text of any float/double.
+#define CF_NUMBER_TEXT_MAX 32
+
+// Writes `value` to `buffer`, which must hold `CF_NUMBER_TEXT_MAX` characters, and returns the end of the text.
+template <typename T>
+static char* s_to_chars(char* buffer, T value)
+{
+	std::to_chars_result result = std::to_chars(buffer, buffer + CF_NUMBER_TEXT_MAX, value);
+	CF_ASSERT(result.ec == std::errc());
+	return result.ptr;
+}
+
+// Reads a number from [s, end), returning one past its last character or NULL if there isn't one.
+template <typename T>
+static const char* s_from_chars(const char* s, const char* end, T* value)
+{
+	std::from_chars_result result = std::from_chars(s, end, *value);
+	if (result.ec != std::errc()) return NULL;
+	return result.ptr;
+}
+
+#ifndef CF_FLOAT_CHARCONV
+static void s_strto(const char* s, char** end, float* value) { *value = strtof(s, end); }
+static void s_strto(const char* s, char** end, double* value) { *value = CF_STRTOD(s, end); }
+
+// Swaps `from` for `to` throughout `s`, to move between '.' and the C locale's decimal point. The text ends at any
+// `to` already in it, so e.g. the ',' in "1,5" is never read as a decimal point.
+static void s_swap_point(char* s, char from, char to)
+{
+	if (from == to) return;
+	for (; *s; ++s) {
+		if (*s == to) {
+			*s = 0;
+			return;
+		}
+		if (*s == from) *s = to;
+	}
+}
+
+// Tries increasing precisions until the text reads back as exactly `value`. `%g` drops trailing zeros, so values with
+// only a few digits are already shortest at the first precision tried.
+template <typename T>
+static char* s_to_chars_float(char* buffer, T value, int min_precision, int max_precision)
+{
+	int n = 0;
+	for (int precision = min_precision; precision <= max_precision; ++precision) {
+		n = CF_SNPRINTF(buffer, CF_NUMBER_TEXT_MAX, "%.*g", precision, (double)value);
+		T parsed;
+		s_strto(buffer, NULL, &parsed);
+		if (parsed == value) break;
+	}
+	s_swap_point(buffer, *localeconv()->decimal_point, '.');
+	return buffer + n;
+}
+
+// strtod wants a terminated string and skips leading whitespace, unlike from_chars. Numbers longer than the local
+// buffer are cut short, which is fine for any number written out by `s_to_chars`.
+template <typename T>
+static const char* s_from_chars_float(const char* s, const char* end, T* value)
+{
+	char buffer[128];
+	int len = (int)cf_min(end - s, (ptrdiff_t)sizeof(buffer) - 1);
+	if (len <= 0 || isspace((unsigned char)*s)) return NULL;
+	CF_MEMCPY(buffer, s, len);
+	buffer[len] = 0;
+	s_swap_point(buffer, '.', *localeconv()->decimal_point);
+	char* stop;
+	errno = 0;
+	s_strto(buffer, &stop, value);
+	if (stop == buffer) return NULL;
+	// Subnormals also report ERANGE, only overflow and underflow to zero are errors like they are for from_chars.
+	if (errno == ERANGE && (*value == 0 || isinf(*value))) return NULL;
+	return s + (stop - buffer);
+}
+
+static char* s_to_chars(char* buffer, float value) { return s_to_chars_float(buffer, value, FLT_DIG, 9); }
+static char* s_to_chars(char* buffer, double value) { return s_to_chars_float(buffer, value, DBL_DIG, 17); }
+static const char* s_from_chars(const char* s, const char* end, float* value) { return s_from_chars_float(s, end, value); }
+static const char* s_from_chars(const char* s, const char* end, double* value) { return s_from_chars_float(s, end, value); }
+#endif
+
+template <typename T>
+static char* s_append_number(char* s, T value)
+{
+	CF_ACANARY(s);
+	sfit(s, slen(s) + CF_NUMBER_TEXT_MAX + 1);
+	char* start = s + slen(s);
+	alen(s) += (int)(s_to_chars(start, value) - start);
+	s[slen(s)] = 0;
+	return s;
+}
+
+char* cf_sappend_int(char* s, int64_t i)
+{
+	return s_append_number(s, i);
+}
+
+char* cf_sappend_uint(char* s, uint64_t i)
+{
+	return s_append_number(s, i);
+}
+
+char* cf_sappend_float(char* s, float f)
+{
+	return s_append_number(s, f);
+}
+
+char* cf_sappend_double(char* s, double d)
+{
+	return s_append_number(s, d);
+}
+
+template <typename T>
+static const char* s_parse_number(const char* s, const char* end, T* value)
+{
+	if (!end) end = s + CF_STRLEN(s);
+	// from_chars rejects a leading '+', but it's common enough in hand-written text to allow it.
+	if (s < end && *s == '+' && s + 1 < end && s[1] != '-') ++s;
+	return s_from_chars(s, end, value);
+}
+
+const char* cf_sparse_int(const char* s, const char* end, int64_t* value)
+{
+	return s_parse_number(s, end, value);
+}
+
+const char* cf_sparse_float(const char* s, const char* end, float* value)
+{
+	return s_parse_number(s, end, value);
+}
+
+const char* cf_sparse_double(const char* s, const char* end, double* value)
+{
+	return s_parse_number(s, end, value);
+}
+
 char* cf_sreplace(char* s, const char* replace_me, const char* with_me)
 {
 	CF_ACANARY(s);
@@ -536,29 +685,39 @@ void cf_sinuke_intern_table()
 // All invalid characters are encoded as the "replacement character" 0xFFFD for both
 // UTF8 and UTF16 functions.
 
-char* cf_string_append_UTF8_impl(char *s, int codepoint)
+static CF_INLINE char* s_encode_UTF8(char* out, int codepoint)
 {
-	CF_ACANARY(s);
 	if (codepoint > 0x10FFFF) codepoint = 0xFFFD;
-#define CF_EMIT(X, Y, Z) spush(s, X | ((codepoint >> Y) & Z))
+#define CF_EMIT(X, Y, Z) *out++ = (char)(X | ((codepoint >> Y) & Z))
 	     if (codepoint <    0x80) { CF_EMIT(0x00,0,0x7F); }
 	else if (codepoint <   0x800) { CF_EMIT(0xC0,6,0x1F); CF_EMIT(0x80, 0,  0x3F); }
 	else if (codepoint < 0x10000) { CF_EMIT(0xE0,12,0xF); CF_EMIT(0x80, 6,  0x3F); CF_EMIT(0x80, 0, 0x3F); }
 	else                          { CF_EMIT(0xF0,18,0x7); CF_EMIT(0x80, 12, 0x3F); CF_EMIT(0x80, 6, 0x3F); CF_EMIT(0x80, 0, 0x3F); }
-	return s;
+#undef CF_EMIT
+	return out;
 }
 
-const char* cf_decode_UTF8(const char* s, int* codepoint)
+char* cf_string_append_UTF8_impl(char *s, int codepoint)
+{
+	CF_ACANARY(s);
+	char buf[4];
+	return cf_sappend_range(s, buf, s_encode_UTF8(buf, codepoint));
+}
+
+static CF_INLINE const char* s_decode_UTF8(const char* s, int* codepoint)
 {
 	unsigned char c = *s++;
+	if (c < 0x80) {
+		*codepoint = c;
+		return s;
+	}
 	int extra = 0;
 	int min = 0;
 	*codepoint = 0;
-			if (c >= 0xF0) { *codepoint = c & 0x07; extra = 3; min = 0x10000; }
+	     if (c >= 0xF0) { *codepoint = c & 0x07; extra = 3; min = 0x10000; }
 	else if (c >= 0xE0) { *codepoint = c & 0x0F; extra = 2; min = 0x800; }
 	else if (c >= 0xC0) { *codepoint = c & 0x1F; extra = 1; min = 0x80; }
-	else if (c >= 0x80) { *codepoint = 0xFFFD; }
-	else *codepoint = c;
+	else *codepoint = 0xFFFD;
 	while (extra--) {
 		c = *s++;
 		if ((c & 0xC0) != 0x80) { *codepoint = 0xFFFD; }
@@ -568,6 +727,86 @@ const char* cf_decode_UTF8(const char* s, int* codepoint)
 	return s;
 }
 
+const char* cf_decode_UTF8(const char* s, int* codepoint)
+{
+	return s_decode_UTF8(s, codepoint);
+}
+
+// Same as `cf_decode_UTF8`, but never reads past `end`. Sequences cut off by `end` decode to 0xFFFD.
+static CF_INLINE const char* s_decode_UTF8_bounded(const char* s, const char* end, int* codepoint)
+{
+	if (end - s < 4) {
+		unsigned char c = *s;
+		int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+		if (end - s <= extra) {
+			*codepoint = 0xFFFD;
+			return end;
+		}
+	}
+	return s_decode_UTF8(s, codepoint);
+}
+
+int cf_decode_UTF8_bulk(const char* s, int len, int* codepoints)
+{
+	const char* end = s + len;
+	int* out = codepoints;
+	while (s < end) {
+		// ASCII fast path, 16 bytes at a time. Bails out on the first byte with the high bit set.
+#if defined(CF_SIMD_SSE2)
+		__m128i zero = _mm_setzero_si128();
+		while (end - s >= 16) {
+			__m128i v = _mm_loadu_si128((const __m128i*)s);
+			int mask = _mm_movemask_epi8(v);
+			if (mask) {
+				int n = cf_ctz32((uint32_t)mask);
+				for (int i = 0; i < n; ++i) out[i] = (unsigned char)s[i];
+				out += n;
+				s += n;
+				break;
+			}
+			__m128i lo = _mm_unpacklo_epi8(v, zero);
+			__m128i hi = _mm_unpackhi_epi8(v, zero);
+			_mm_storeu_si128((__m128i*)out + 0, _mm_unpacklo_epi16(lo, zero));
+			_mm_storeu_si128((__m128i*)out + 1, _mm_unpackhi_epi16(lo, zero));
+			_mm_storeu_si128((__m128i*)out + 2, _mm_unpacklo_epi16(hi, zero));
+			_mm_storeu_si128((__m128i*)out + 3, _mm_unpackhi_epi16(hi, zero));
+			out += 16;
+			s += 16;
+		}
+#elif defined(CF_SIMD_NEON)
+		while (end - s >= 16) {
+			uint8x16_t v = vld1q_u8((const uint8_t*)s);
+			if (vmaxvq_u8(v) >= 0x80) break;
+			uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+			uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+			vst1q_s32(out +  0, vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(lo))));
+			vst1q_s32(out +  4, vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(lo))));
+			vst1q_s32(out +  8, vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(hi))));
+			vst1q_s32(out + 12, vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(hi))));
+			out += 16;
+			s += 16;
+		}
+#else
+		while (end - s >= 8) {
+			uint64_t v;
+			CF_MEMCPY(&v, s, 8);
+			if (v & 0x8080808080808080ULL) break;
+			for (int i = 0; i < 8; ++i) out[i] = (unsigned char)s[i];
+			out += 8;
+			s += 8;
+		}
+#endif
+		if (s >= end) break;
+
+		// Decode one character, then keep going one at a time through any run of non-ASCII characters
+		// (e.g. CJK text) so the fast path isn't retried on every single character.
+		do {
+			s = s_decode_UTF8_bounded(s, end, out++);
+		} while (s < end && (unsigned char)*s >= 0x80);
+	}
+	return (int)(out - codepoints);
+}
+
 const uint16_t* cf_decode_UTF16(const uint16_t* s, int* codepoint)
 {
 	int W1 = *s++;
@@ -580,3 +819,184 @@ const uint16_t* cf_decode_UTF16(const uint16_t* s, int* codepoint)
 	} else *codepoint = 0xFFFD;
 	return s;
 }
+
+char* cf_string_append_UTF16_impl(char* s, const uint16_t* text, int len)
+{
+	CF_ACANARY(s);
+	if (len < 0) {
+		len = 0;
+		while (text[len]) ++len;
+	}
+	if (len <= 0) return s;
+
+	// Each UTF16 code unit becomes at most three UTF8 bytes (a surrogate pair is two units for four bytes).
+	sfit(s, slen(s) + len * 3 + 1);
+	char* out = s + slen(s);
+	const uint16_t* end = text + len;
+	while (text < end) {
+		// ASCII fast path, 8 code units at a time.
+#if defined(CF_SIMD_SSE2)
+		__m128i not_ascii = _mm_set1_epi16((short)0xFF80);
+		__m128i zero = _mm_setzero_si128();
+		while (end - text >= 8) {
+			__m128i v = _mm_loadu_si128((const __m128i*)text);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, not_ascii), zero)) != 0xFFFF) break;
+			_mm_storel_epi64((__m128i*)out, _mm_packus_epi16(v, v));
+			out += 8;
+			text += 8;
+		}
+#elif defined(CF_SIMD_NEON)
+		while (end - text >= 8) {
+			uint16x8_t v = vld1q_u16(text);
+			if (vmaxvq_u16(v) >= 0x80) break;
+			vst1_u8((uint8_t*)out, vmovn_u16(v));
+			out += 8;
+			text += 8;
+		}
+#endif
+		if (text >= end) break;
+
+		int cp;
+		int W1 = *text++;
+		if (W1 < 0x80) {
+			*out++ = (char)W1;
+			continue;
+		} else if (W1 < 0xD800 || W1 > 0xDFFF) {
+			cp = W1;
+		} else if (W1 <= 0xDBFF && text < end && *text >= 0xDC00 && *text <= 0xDFFF) {
+			cp = 0x10000 + (((W1 & 0x03FF) << 10) | (*text++ & 0x03FF));
+		} else {
+			cp = 0xFFFD;
+		}
+		out = s_encode_UTF8(out, cp);
+	}
+	alen(s) = (int)(out - s) + 1;
+	*out = 0;
+	return s;
+}
+
+//--------------------------------------------------------------------------------------------------
+// String builder.
+
+#define CF_STRING_BUILDER_DEFAULT_CHUNK_SIZE 4096
+#define CF_STRING_BUILDER_CHUNKS_PER_BLOCK   4
+
+void cf_string_builder_init(CF_StringBuilder* sb, int chunk_size)
+{
+	CF_MEMSET(sb, 0, sizeof(*sb));
+	if (chunk_size <= 0) chunk_size = CF_STRING_BUILDER_DEFAULT_CHUNK_SIZE;
+	sb->chunk_size = CF_ALIGN_FORWARD(chunk_size, 8);
+	cf_arena_init(&sb->arena, 8, sb->chunk_size * CF_STRING_BUILDER_CHUNKS_PER_BLOCK + 1);
+}
+
+void cf_string_builder_destroy(CF_StringBuilder* sb)
+{
+	cf_arena_reset(&sb->arena);
+	afree(sb->chunks);
+	CF_MEMSET(sb, 0, sizeof(*sb));
+}
+
+void cf_string_builder_clear(CF_StringBuilder* sb)
+{
+	sb->chunk_count = 0;
+	sb->len = 0;
+}
+
+// Returns a chunk with at least one free byte, pulling in a new (or previously used) chunk if needed.
+static CF_StringChunk* s_builder_chunk(CF_StringBuilder* sb)
+{
+	if (sb->chunk_count) {
+		CF_StringChunk* chunk = sb->chunks + sb->chunk_count - 1;
+		if (chunk->len < sb->chunk_size) return chunk;
+	}
+	if (sb->chunk_count == acount(sb->chunks)) {
+		CF_StringChunk chunk;
+		chunk.data = (char*)cf_arena_alloc(&sb->arena, sb->chunk_size);
+		chunk.len = 0;
+		apush(sb->chunks, chunk);
+	}
+	CF_StringChunk* chunk = sb->chunks + sb->chunk_count++;
+	chunk->len = 0;
+	return chunk;
+}
+
+void cf_string_builder_append_range(CF_StringBuilder* sb, const char* start, const char* end)
+{
+	while (start < end) {
+		CF_StringChunk* chunk = s_builder_chunk(sb);
+		int n = cf_min((int)(end - start), sb->chunk_size - chunk->len);
+		CF_MEMCPY(chunk->data + chunk->len, start, n);
+		chunk->len += n;
+		sb->len += n;
+		start += n;
+	}
+}
+
+void cf_string_builder_append(CF_StringBuilder* sb, const char* s)
+{
+	cf_string_builder_append_range(sb, s, s + CF_STRLEN(s));
+}
+
+void cf_string_builder_fmt(CF_StringBuilder* sb, const char* fmt, ...)
+{
+	// Try formatting straight into the current chunk first. vsnprintf always wants room for a
+	// nul-terminator, so only use the chunk if the text fits with a byte to spare.
+	CF_StringChunk* chunk = s_builder_chunk(sb);
+	int capacity = sb->chunk_size - chunk->len;
+	va_list args;
+	va_start(args, fmt);
+	int n = vsnprintf(chunk->data + chunk->len, capacity, fmt, args);
+	va_end(args);
+	if (n < 0) return;
+	if (n < capacity) {
+		chunk->len += n;
+		sb->len += n;
+		return;
+	}
+
+	// Too big for the current chunk, format into scratch memory and append that instead.
+	char buffer[256];
+	char* text = n < (int)sizeof(buffer) ? buffer : (char*)cf_alloc(n + 1);
+	va_start(args, fmt);
+	vsnprintf(text, n + 1, fmt, args);
+	va_end(args);
+	cf_string_builder_append_range(sb, text, text + n);
+	if (text != buffer) cf_free(text);
+}
+
+void cf_string_builder_append_int(CF_StringBuilder* sb, int64_t i)
+{
+	char buffer[CF_NUMBER_TEXT_MAX];
+	cf_string_builder_append_range(sb, buffer, s_to_chars(buffer, i));
+}
+
+void cf_string_builder_append_float(CF_StringBuilder* sb, float f)
+{
+	char buffer[CF_NUMBER_TEXT_MAX];
+	cf_string_builder_append_range(sb, buffer, s_to_chars(buffer, f));
+}
+
+int cf_string_builder_len(const CF_StringBuilder* sb)
+{
+	return sb->len;
+}
+
+char* cf_string_builder_to_string(const CF_StringBuilder* sb)
+{
+	char* s = NULL;
+	sfit(s, sb->len);
+	char* out = s;
+	for (int i = 0; i < sb->chunk_count; ++i) {
+		CF_MEMCPY(out, sb->chunks[i].data, sb->chunks[i].len);
+		out += sb->chunks[i].len;
+	}
+	*out = 0;
+	alen(s) = sb->len + 1;
+	return s;
+}
+
+const CF_StringChunk* cf_string_builder_chunks(const CF_StringBuilder* sb, int* count)
+{
+	*count = sb->chunk_count;
+	return sb->chunks;
+}
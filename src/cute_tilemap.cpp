@@ -0,0 +1,172 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#include <cute_tilemap.h>
+#include <cute_alloc.h>
+#include <cute_array.h>
+#include <cute_c_runtime.h>
+
+#include <internal/cute_alloc_internal.h>
+#include <internal/cute_draw_internal.h>
+
+using namespace Cute;
+
+struct CF_TilemapChunk
+{
+	bool dirty = true;
+	CF_Aabb bounds; // Local to the tilemap, in world units.
+	Array<spritebatch_sprite_t> items; // Quads are local to the tilemap, transformed at draw time.
+};
+
+struct CF_TilemapInternal
+{
+	int w = 0;
+	int h = 0;
+	float tile_w = 0;
+	float tile_h = 0;
+	int chunks_x = 0;
+	int chunks_y = 0;
+	Array<int> tiles;
+	Array<CF_TilemapChunk> chunks;
+	Array<CF_Sprite> tile_sprites; // Indexed by tile id.
+	Array<bool> has_tile_sprite;
+};
+
+CF_Tilemap cf_make_tilemap(int w, int h, float tile_w, float tile_h)
+{
+	// An empty map would have no chunks to draw or tiles to index, so keep at least one tile.
+	w = max(w, 1);
+	h = max(h, 1);
+	CF_TilemapInternal* map = CF_NEW(CF_TilemapInternal);
+	map->w = w;
+	map->h = h;
+	map->tile_w = tile_w;
+	map->tile_h = tile_h;
+	map->tiles.ensure_count(w * h);
+	CF_MEMSET(map->tiles.data(), 0, sizeof(int) * w * h);
+	map->chunks_x = (w + CF_TILEMAP_CHUNK_SIZE - 1) / CF_TILEMAP_CHUNK_SIZE;
+	map->chunks_y = (h + CF_TILEMAP_CHUNK_SIZE - 1) / CF_TILEMAP_CHUNK_SIZE;
+	map->chunks.ensure_count(map->chunks_x * map->chunks_y);
+	for (int y = 0; y < map->chunks_y; ++y) {
+		for (int x = 0; x < map->chunks_x; ++x) {
+			int x1 = min(w, (x + 1) * CF_TILEMAP_CHUNK_SIZE);
+			int y1 = min(h, (y + 1) * CF_TILEMAP_CHUNK_SIZE);
+			CF_Aabb bounds = make_aabb(V2((float)(x * CF_TILEMAP_CHUNK_SIZE) * tile_w, (float)(y * CF_TILEMAP_CHUNK_SIZE) * tile_h), V2((float)x1 * tile_w, (float)y1 * tile_h));
+			map->chunks[y * map->chunks_x + x].bounds = bounds;
+		}
+	}
+	CF_Tilemap result = { (uint64_t)map };
+	return result;
+}
+
+void cf_destroy_tilemap(CF_Tilemap tilemap)
+{
+	CF_TilemapInternal* map = (CF_TilemapInternal*)tilemap.id;
+	map->~CF_TilemapInternal();
+	CF_FREE(map);
+}
+
+void cf_tilemap_set_tile_sprite(CF_Tilemap tilemap, int tile_id, const CF_Sprite* sprite)
+{
+	CF_TilemapInternal* map = (CF_TilemapInternal*)tilemap.id;
+	CF_ASSERT(tile_id > 0);
+	CF_ASSERT(sprite);
+	while (map->tile_sprites.count() <= tile_id) {
+		map->tile_sprites.add(cf_sprite_defaults());
+		map->has_tile_sprite.add(false);
+	}
+	map->tile_sprites[tile_id] = *sprite;
+	map->has_tile_sprite[tile_id] = true;
+	for (int i = 0; i < map->chunks.count(); ++i) {
+		map->chunks[i].dirty = true;
+	}
+}
+
+void cf_tilemap_set(CF_Tilemap tilemap, int x, int y, int tile_id)
+{
+	CF_TilemapInternal* map = (CF_TilemapInternal*)tilemap.id;
+	CF_ASSERT(x >= 0 && x < map->w && y >= 0 && y < map->h);
+	CF_ASSERT(tile_id >= 0);
+	int& tile = map->tiles[y * map->w + x];
+	if (tile == tile_id) return;
+	tile = tile_id;
+	map->chunks[(y / CF_TILEMAP_CHUNK_SIZE) * map->chunks_x + x / CF_TILEMAP_CHUNK_SIZE].dirty = true;
+}
+
+int cf_tilemap_get(CF_Tilemap tilemap, int x, int y)
+{
+	CF_TilemapInternal* map = (CF_TilemapInternal*)tilemap.id;
+	CF_ASSERT(x >= 0 && x < map->w && y >= 0 && y < map->h);
+	return map->tiles[y * map->w + x];
+}
+
+// Regenerates the spritebatch items for every non-empty tile within a chunk.
+static void s_rebuild_chunk(CF_TilemapInternal* map, int cx, int cy)
+{
+	CF_TilemapChunk& chunk = map->chunks[cy * map->chunks_x + cx];
+	chunk.items.clear();
+	int x0 = cx * CF_TILEMAP_CHUNK_SIZE;
+	int y0 = cy * CF_TILEMAP_CHUNK_SIZE;
+	int x1 = min(map->w, x0 + CF_TILEMAP_CHUNK_SIZE);
+	int y1 = min(map->h, y0 + CF_TILEMAP_CHUNK_SIZE);
+	CF_M3x2 identity = cf_make_identity();
+	for (int y = y0; y < y1; ++y) {
+		for (int x = x0; x < x1; ++x) {
+			int id = map->tiles[y * map->w + x];
+			if (!id || id >= map->tile_sprites.count() || !map->has_tile_sprite[id]) continue;
+			CF_Sprite sprite = map->tile_sprites[id];
+			sprite.transform = cf_make_transform();
+			sprite.transform.p = V2(((float)x + 0.5f) * map->tile_w, ((float)y + 0.5f) * map->tile_h);
+			sprite.scale = V2(map->tile_w / (float)sprite.w, map->tile_h / (float)sprite.h);
+			spritebatch_sprite_t s;
+			cf_draw_make_sprite_item(&sprite, identity, &s);
+			chunk.items.add(s);
+		}
+	}
+	chunk.dirty = false;
+}
+
+void cf_draw_tilemap(CF_Tilemap tilemap, CF_V2 position)
+{
+	CF_TilemapInternal* map = (CF_TilemapInternal*)tilemap.id;
+	CF_M3x2 m = mul(draw->mvp, cf_make_translation(position));
+	CF_Color user_params = draw->user_params.last();
+
+	for (int cy = 0; cy < map->chunks_y; ++cy) {
+		for (int cx = 0; cx < map->chunks_x; ++cx) {
+			CF_TilemapChunk& chunk = map->chunks[cy * map->chunks_x + cx];
+
+			// Skip chunks entirely outside the canvas, tested in clip space where the canvas spans -1 to 1. Draw lists
+			// may be submitted later with a different transform, so every chunk is kept while recording one.
+			if (!draw->recording) {
+				v2 corners[4];
+				aabb_verts(corners, chunk.bounds);
+				v2 lo = mul(m, corners[0]);
+				v2 hi = lo;
+				for (int i = 1; i < 4; ++i) {
+					v2 p = mul(m, corners[i]);
+					lo = cf_min_v2(lo, p);
+					hi = cf_max_v2(hi, p);
+				}
+				if (lo.x > 1.0f || lo.y > 1.0f || hi.x < -1.0f || hi.y < -1.0f) continue;
+			}
+
+			if (chunk.dirty) s_rebuild_chunk(map, cx, cy);
+
+			draw->items.ensure_capacity(draw->items.count() + chunk.items.count());
+			for (int i = 0; i < chunk.items.count(); ++i) {
+				spritebatch_sprite_t& s = draw->add_item();
+				s = chunk.items[i];
+				s.geom.shape[0] = mul(m, s.geom.shape[0]);
+				s.geom.shape[1] = mul(m, s.geom.shape[1]);
+				s.geom.shape[2] = mul(m, s.geom.shape[2]);
+				s.geom.shape[3] = mul(m, s.geom.shape[3]);
+				s.geom.user_params = user_params;
+			}
+		}
+	}
+}
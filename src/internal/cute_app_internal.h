@@ -80,11 +80,13 @@ struct CF_App
 	Cute::Map<const char*, CF_ShaderFileInfo> shader_file_infos;
 	Cute::Map<const char*, const char*> builtin_shaders;
 	bool gfx_enabled = false;
+	bool gfx_null = false;
 	float dpi_scale = 1.0f;
 	float dpi_scale_prev = 1.0f;
 	bool dpi_scale_was_changed = false;
 	bool sync_window = false;
 	int draw_call_count = 0;
+	int render_pass_count = 0;
 	int w;
 	int h;
 	int x;
@@ -97,6 +99,8 @@ struct CF_App
 	CF_Canvas offscreen_canvas = { };
 	CF_Mesh backbuffer_quad = { };
 	CF_Shader draw_shader = { };
+	CF_Shader draw_sprite_shader = { };
+	CF_Shader draw_instanced_shader = { };
 	CF_Shader basic_shader = { };
 	CF_Shader backbuffer_shader = { };
 	CF_Material backbuffer_material = { };
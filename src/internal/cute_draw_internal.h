@@ -12,6 +12,7 @@
 #include <cute_math.h>
 #include <cute_draw.h>
 #include <cute_graphics.h>
+#include <cute_binary.h>
 
 #include <float.h>
 
@@ -46,6 +47,7 @@ struct BatchGeometry
 	bool fill;
 	bool unused;
 	CF_Color user_params;
+	int16_t clip[4]; // Filled in by `cf_render_to`, see `CF_Vertex::clip`.
 };
 
 #define SPRITEBATCH_SPRITE_GEOMETRY BatchGeometry
@@ -53,6 +55,72 @@ struct BatchGeometry
 #define SPRITEBATCH_ASSERT CF_ASSERT
 #include <cute/cute_spritebatch.h>
 
+// Compact vertex layout used for batches made up entirely of sprites/text (`BATCH_GEOMETRY_TYPE_SPRITE`).
+// Sprites don't need any of the shape fields in `CF_Vertex`, so this cuts vertex bandwidth by over 3x.
+// The layout of `type` through `unused` must match `CF_Vertex` since it's read as a single UBYTE4_NORM.
+struct CF_SpriteVertex
+{
+	CF_V2 posH;
+	CF_V2 uv;
+	CF_Pixel color;
+	uint8_t type;
+	uint8_t alpha;
+	uint8_t fill;
+	uint8_t unused;
+	CF_Color attributes;
+	int16_t clip[4];
+};
+
+// One record per shape or sprite when drawing with instancing, expanded over a shared unit quad by the
+// instanced vertex shader. Replaces six fully duplicated `CF_Vertex`s. Corners are stored in winding
+// order, e.g. `p[0] -> p[1] -> p[2] -> p[3]`.
+struct CF_DrawInstance
+{
+	CF_V2 p[4];
+	CF_V2 posH[4];
+	CF_V2 shape[8];
+	CF_V2 uv_min;
+	CF_V2 uv_max;
+	int n;
+	CF_Pixel color;
+	float radius;
+	float stroke;
+	float aa;
+	uint8_t type;
+	uint8_t alpha;
+	uint8_t fill;
+	uint8_t unused;
+	CF_Color attributes;
+	int16_t clip[4];
+};
+
+// Vertex layout for blitting canvases onto the render target, six per blit.
+struct CF_BlitVertex
+{
+	CF_V2 pos;  // World space x/y.
+	CF_V2 posH; // posH, homogenous (multiplied by mvp).
+	CF_V2 uv;   // UV to read from src.
+	CF_Color params;
+};
+
+// A draw call recorded by `cf_render_to`. Vertices for all batches are gathered up front and uploaded once,
+// then each batch draws its own sub-range of the mesh. See `cf_mesh_set_draw_range`.
+struct CF_DrawBatch
+{
+	int cmd_index;       // The command whose state this batch is drawn with.
+	CF_Shader shader;
+	CF_Mesh mesh;
+	int first_vertex;
+	int vertex_count;
+	int first_instance;
+	int instance_count;
+	int index_count;     // Zero to keep the mesh's current index count.
+	uint64_t texture_id;
+	int texture_w;
+	int texture_h;
+	bool is_blit;        // Blits the target texture of `cmds[cmd_index].canvas` (stored in `texture_id`) instead of an atlas.
+};
+
 struct CF_Strike
 {
 	CF_V2 p0, p1;
@@ -79,9 +147,11 @@ struct CF_Command
 	float alpha_discard = 1.0f;
 	CF_RenderState render_state;
 	CF_Shader shader;
-	Cute::Array<spritebatch_sprite_t> items;
+	int item_start = 0; // Range of this command's items within `CF_Draw::items`.
+	int item_count = 0;
 	CF_DrawUniform u;
 	bool is_canvas = false;
+	bool is_canvas_item = false; // Holds a single canvas drawn as a sprite, only merged with draws of the same canvas.
 	CF_Canvas canvas = { 0 };
 	CF_V2 canvas_verts[4];
 	CF_V2 canvas_verts_posH[4];
@@ -89,7 +159,7 @@ struct CF_Command
 };
 
 #define DRAW_PUSH_ITEM(s) \
-	draw->cmds.last().items.add(s)
+	cf_draw_push_item(s)
 
 #define PUSH_DRAW_VAR(var) \
 	draw->var##s.add(var)
@@ -125,6 +195,130 @@ struct CF_Command
 	draw->add_cmd(); \
 	draw->cmds.last().u = u
 
+// A node of the triangulator's sweep status, a treap of edges ordered by where they cross the sweep line.
+struct CF_TriangulatorNode
+{
+	int left;                        // Indices into `CF_Triangulator::status`, or -1.
+	int right;
+	int parent;
+	uint32_t priority;               // Parents always have a higher priority than their children.
+};
+
+// An outgoing half-edge of a vertex, see `CF_Triangulator::edges`.
+struct CF_TriangulatorEdge
+{
+	int to;
+	float angle;                     // Direction of the edge, `atan2` of its delta.
+};
+
+// Scratch space for `cf_draw_polygon_fill_simple`, kept around to avoid allocating each call.
+struct CF_Triangulator
+{
+	Cute::Array<CF_V2> points;       // The polygon without duplicate or collinear vertices, in CCW order.
+	Cute::Array<int> index;          // Maps `points` back to the caller's indices.
+	Cute::Array<int> type;
+	Cute::Array<int> order;          // Indices of `points` sorted top to bottom.
+	Cute::Array<CF_TriangulatorNode> status; // Left-chain edges crossing the sweep line, one node per edge.
+	int status_root = -1;
+	Cute::Array<int> helper;
+	Cute::Array<int> diagonals;      // Pairs of indices into `points`.
+	Cute::Array<int> edge_offset;    // Outgoing half-edges of each vertex are `edges[edge_offset[i] .. edge_offset[i + 1]]`.
+	Cute::Array<CF_TriangulatorEdge> edges; // Sorted CCW around each vertex.
+	Cute::Array<bool> edge_visited;
+	Cute::Array<int> face;
+	Cute::Array<int> sorted;
+	Cute::Array<bool> is_left;
+	Cute::Array<int> stack;
+	Cute::Array<int> indices;        // Output triangles as triples of the caller's indices.
+};
+
+// A triangulated polygon cached by `cf_draw_polygon_fill_simple`, see `cf_draw_set_tessellation_cache`.
+struct CF_TessellationEntry
+{
+	Cute::Array<CF_V2> points;       // Compared on lookup to rule out hash collisions.
+	Cute::Array<int> indices;
+	bool used = true;                // Entries unused for a whole frame are evicted.
+};
+
+// Commands captured by `cf_draw_list_begin`/`cf_draw_list_end`. Uniform data is copied out of the draw's frame
+// arena into `uniform_arena`, since the former is reset each `cf_render_to`.
+struct CF_DrawListInternal
+{
+	Cute::Array<CF_Command> cmds;
+	Cute::Array<spritebatch_sprite_t> items; // Item ranges of `cmds` point in here.
+	CF_M3x2 inv_mvp; // Maps the recorded clip-space positions back out of the camera used while recording.
+	CF_Arena uniform_arena;
+};
+
+// Captures written by `cf_draw_capture_end` are a binary container (see `CF_BinaryWriter`) holding one section for
+// each of the arrays below. Everything is in native byte order, so captures replay on the platform they were made on.
+#define CF_DRAW_CAPTURE_VERSION 1
+
+enum CF_DrawCaptureMesh : int32_t
+{
+	CF_DRAW_CAPTURE_MESH_TRIS,      // `CF_Draw::tri_verts`, drawn with `CF_Draw::mesh`.
+	CF_DRAW_CAPTURE_MESH_QUADS,     // `CF_Draw::verts`, drawn with `CF_Draw::quad_mesh`.
+	CF_DRAW_CAPTURE_MESH_SPRITES,   // `CF_Draw::sprite_verts`, drawn with `CF_Draw::sprite_mesh`.
+	CF_DRAW_CAPTURE_MESH_INSTANCES, // `CF_Draw::instances`, drawn with `CF_Draw::instance_mesh`.
+	CF_DRAW_CAPTURE_MESH_BLITS,     // `CF_Draw::blit_verts`, drawn with `CF_Draw::blit_mesh`.
+	CF_DRAW_CAPTURE_MESH_COUNT,
+};
+
+// The "draw.header" section. Struct sizes and strides are stored so a capture from an incompatible build is rejected.
+struct CF_DrawCaptureHeader
+{
+	uint32_t version;
+	uint32_t pass_size;
+	uint32_t batch_size;
+	uint32_t uniform_size;
+	uint32_t strides[CF_DRAW_CAPTURE_MESH_COUNT];
+};
+
+// One `cf_render_to` call, in the "draw.passes" section.
+struct CF_DrawCapturePass
+{
+	int32_t canvas_w;
+	int32_t canvas_h;
+	int32_t clear;
+	int32_t batch_start;    // Range within "draw.batches".
+	int32_t batch_count;
+	int32_t uniform_start;  // Uniforms set after the last batch, range within "draw.uniforms".
+	int32_t uniform_count;
+	int32_t vertex_count[CF_DRAW_CAPTURE_MESH_COUNT];
+	uint64_t vertex_offset[CF_DRAW_CAPTURE_MESH_COUNT]; // Into "draw.vertices".
+};
+
+// A `CF_DrawBatch` along with the state of its command, in the "draw.batches" section.
+struct CF_DrawCaptureBatch
+{
+	int32_t mesh;           // A `CF_DrawCaptureMesh`.
+	int32_t first_vertex;
+	int32_t vertex_count;
+	int32_t first_instance;
+	int32_t instance_count;
+	int32_t index_count;
+	int32_t texture_w;
+	int32_t texture_h;
+	uint64_t texture_id;    // Atlas (or canvas) texture id at capture time, only meaningful for telling textures apart.
+	int32_t uniform_start;  // Uniforms set before this batch, range within "draw.uniforms".
+	int32_t uniform_count;
+	int32_t custom_shader;  // Drawn with a shader from `cf_make_draw_shader`, replayed with the built-in one instead.
+	float alpha_discard;
+	CF_Rect viewport;
+	CF_Rect scissor;        // Only the hardware scissor, per-vertex scissors live in the vertices.
+	CF_RenderState render_state;
+};
+
+// A uniform from `cf_draw_set_uniform`, in the "draw.uniforms" section. Texture uniforms aren't captured.
+struct CF_DrawCaptureUniform
+{
+	uint32_t name;          // Offset into the string table, see `cf_binary_string`.
+	int32_t type;           // A `CF_UniformType`.
+	int32_t array_length;
+	int32_t size;
+	uint64_t data_offset;   // Into "draw.uniform_data".
+};
+
 struct CF_Draw
 {
 	CF_INLINE CF_Command& add_cmd() {
@@ -136,23 +330,53 @@ struct CF_Draw
 		cmd.alpha_discard = alpha_discards.last();
 		cmd.render_state = render_states.last();
 		cmd.shader = shaders.last();
+		cmd.item_start = items.count();
 		return cmd;
 	}
+	// Items always go into the last command, so each command's items stay contiguous.
+	CF_INLINE spritebatch_sprite_t& add_item() {
+		cmds.last().item_count++;
+		return items.add();
+	}
+	CF_INLINE void pop_item() {
+		cmds.last().item_count--;
+		items.pop();
+	}
 	int cmd_index = 0;
 	int draw_item_order = 0;
 	Cute::Array<CF_Command> cmds;
+	Cute::Array<spritebatch_sprite_t> items; // Every item drawn this frame, cleared along with `cmds`.
 	Cute::Array<CF_Vertex> verts;
+	Cute::Array<CF_Vertex> tri_verts;
+	Cute::Array<CF_SpriteVertex> sprite_verts;
+	Cute::Array<CF_DrawInstance> instances;
+	Cute::Array<CF_BlitVertex> blit_verts;
+	Cute::Array<CF_DrawBatch> batches;
 	CF_V2 atlas_dims = cf_v2(2048, 2048);
 	CF_V2 texel_dims = cf_v2(1.0f/2048.0f, 1.0f/2048.0f);
 	bool delay_defrag = false;
 	spritebatch_t sb;
 	CF_Mesh mesh;
+	CF_Mesh quad_mesh;
+	int quad_index_capacity = 0;
+	int quad_index_bits = 0;
+	CF_Mesh sprite_mesh;
+	CF_Mesh instance_mesh;
+	bool instancing = true;
+	int parallel_threshold = 8192;
+	bool batch_reordering = false;
+	bool vertex_scissor = false;
+	Cute::Array<CF_Command> reorder_cmds;
+	Cute::Array<CF_Aabb> reorder_bounds; // Clip-space bounds of each command's items.
+	Cute::Array<int> reorder_pending;
+	Cute::Array<int> reorder_skipped;
 	CF_Material material;
 	CF_Arena uniform_arena;
 	Cute::Array<float> alpha_discards = { true };
 	Cute::Array<CF_Color> colors = { cf_color_white() };
 	Cute::Array<bool> antialias = { true };
 	Cute::Array<float> antialias_scale = { 1.5f };
+	Cute::Array<bool> culling = { false };
 	Cute::Array<CF_RenderState> render_states;
 	Cute::Array<CF_Rect> scissors = { { 0, 0, -1, -1 } };
 	Cute::Array<CF_Rect> viewports = { { 0, 0, -1, -1 } };
@@ -175,14 +399,35 @@ struct CF_Draw
 	Cute::Array<bool> text_effects = { true };
 	Cute::Map<uint64_t, CF_AtlasSubImage> premade_sub_image_id_to_sub_image;
 	Cute::Map<uint64_t, uint64_t> draw_shd_to_blit_shd;
+	Cute::Map<uint64_t, uint64_t> draw_shd_to_sprite_shd;
+	Cute::Map<uint64_t, uint64_t> draw_shd_to_instanced_shd;
 	bool blit_init = false;
 	CF_Mesh blit_mesh = { 0 };
 	CF_VertexFn* vertex_fn = NULL;
 	bool has_drawn_something = false;
+	CF_DrawStats stats = { };
+	CF_DrawStats stats_prev = { };
+	CF_Triangulator triangulator;
+	bool tessellation_cache = false;
+	Cute::Map<uint64_t, CF_TessellationEntry*> tessellations;
+	CF_DrawListInternal* recording = NULL;
+	int recording_start = 0; // Index into `cmds` of the first recorded command.
+	bool capturing = false;
+	CF_BinaryWriter capture_writer = { 0 }; // Only used for its string table until `cf_draw_capture_end`.
+	Cute::Array<CF_DrawCapturePass> capture_passes;
+	Cute::Array<CF_DrawCaptureBatch> capture_batches;
+	Cute::Array<CF_DrawCaptureUniform> capture_uniforms;
+	Cute::Array<uint8_t> capture_uniform_data;
+	Cute::Array<uint8_t> capture_vertices;
+	Cute::Map<uint64_t, CF_Texture> replay_textures; // Blank stand-ins for captured textures, kept across replays.
 };
 
 void cf_make_draw();
 void cf_destroy_draw();
+void cf_draw_push_item(const spritebatch_sprite_t& s);
+void cf_draw_make_sprite_item(const CF_Sprite* sprite, CF_M3x2 m, spritebatch_sprite_t* out);
+void cf_draw_evict_tessellations(bool all);
+bool cf_triangulate(CF_Triangulator* t, const CF_V2* points, int count);
 
 // We slice up a 64-bit int into lo + hi ranges to map where we can fetch pixels
 // from. This slices up the 64-bit range into 16 unique range. The ranges are inclusive.
@@ -197,6 +442,8 @@ void cf_destroy_draw();
 #define CF_EASY_ID_RANGE_HI      (CF_EASY_ID_RANGE_LO     + CF_IMAGE_ID_RANGE_SIZE)
 #define CF_PREMADE_ID_RANGE_LO   (CF_EASY_ID_RANGE_HI     + 1)
 #define CF_PREMADE_ID_RANGE_HI   (CF_PREMADE_ID_RANGE_LO  + CF_IMAGE_ID_RANGE_SIZE)
+#define CF_CANVAS_ID_RANGE_LO    (CF_PREMADE_ID_RANGE_HI  + 1)
+#define CF_CANVAS_ID_RANGE_HI    (CF_CANVAS_ID_RANGE_LO   + CF_IMAGE_ID_RANGE_SIZE)
 
 SPRITEBATCH_U64 cf_generate_texture_handle(void* pixels, int w, int h, void* udata);
 void cf_destroy_texture_handle(SPRITEBATCH_U64 texture_id, void* udata);
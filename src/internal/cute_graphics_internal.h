@@ -10,6 +10,7 @@
 
 #include <SDL3/SDL.h>
 #include <cute_array.h>
+#include <cute_hashtable.h>
 
 CF_INLINE SDL_GPUTextureCreateInfo SDL_GPUTextureCreateInfoDefaults(int w, int h)
 {
@@ -36,6 +37,7 @@ struct CF_CanvasInternal
 	SDL_GPUTexture* depth_stencil;
 
 	bool clear;
+	bool premade_registered; // Registered with the draw's spritebatch by `cf_draw_canvas`.
 
 	// These get set by cf_apply_* functions.
 	struct CF_MeshInternal* mesh;
@@ -394,33 +396,56 @@ struct CF_MaterialTex
 	CF_Texture handle;
 };
 
+#define CF_MAX_UNIFORM_BLOCK_COUNT (4)
+
+struct CF_UniformBinding
+{
+	int uniform_index; // Into `CF_MaterialState::uniforms`.
+	int offset;        // Within the uniform block.
+	int size;
+};
+
+// Maps the uniforms of a material straight onto the uniform blocks of a shader, precomputed once per shader
+// and material (see `CF_MaterialState::plans`). Also holds persistent copies of the uniform blocks,
+// refilled only when the material's uniform values change.
+struct CF_UniformPlan
+{
+	uint64_t version = 0; // The `CF_MaterialState::version` the blocks were last filled from.
+	Cute::Array<CF_UniformBinding> bindings[CF_MAX_UNIFORM_BLOCK_COUNT];
+	void* blocks[CF_MAX_UNIFORM_BLOCK_COUNT] = { };
+	int block_sizes[CF_MAX_UNIFORM_BLOCK_COUNT] = { };
+};
+
 struct CF_MaterialState
 {
 	Cute::Array<CF_Uniform> uniforms;
 	Cute::Array<CF_MaterialTex> textures;
+	Cute::Map<uint64_t, CF_UniformPlan*> plans; // Keyed by `CF_ShaderInternal::id`, dropped whenever a uniform is added or the uniforms are cleared.
+	uint64_t version = 0; // Bumped whenever the value of a uniform changes.
 };
 
 struct CF_MaterialInternal
 {
-	bool dirty = false;
 	CF_RenderState state;
+	uint64_t state_hash = 0; // Hash of the parts of `state` baked into pipelines, see `cf_material_set_render_state`.
 	CF_MaterialState vs;
 	CF_MaterialState fs;
 	CF_Arena uniform_arena;
-	CF_Arena block_arena;
 };
 
-struct CF_Pipeline
+#define CF_PIPELINE_KEY_COUNT 5
+
+// A pipeline along with the full key it was built for. The cache is indexed by a hash of the key, so the key itself
+// is compared on lookup to rule out collisions.
+struct CF_CachedPipeline
 {
-	CF_MaterialInternal* material = NULL;
-	SDL_GPUGraphicsPipeline* pip = NULL;
-	CF_MeshInternal* mesh = NULL;
+	uint64_t key[CF_PIPELINE_KEY_COUNT];
+	SDL_GPUGraphicsPipeline* pip;
 };
 
-#define CF_MAX_UNIFORM_BLOCK_COUNT (4)
-
 struct CF_ShaderInternal
 {
+	uint64_t id = 0; // Unique across all shaders, never reused even after this shader is destroyed.
 	SDL_GPUShader* vs = NULL;
 	SDL_GPUShader* fs = NULL;
 	int input_count = 0;
@@ -433,7 +458,7 @@ struct CF_ShaderInternal
 	Cute::Array<CF_UniformBlockMember> fs_uniform_block_members[CF_MAX_UNIFORM_BLOCK_COUNT];
 	Cute::Array<CF_UniformBlockMember> vs_uniform_block_members[CF_MAX_UNIFORM_BLOCK_COUNT];
 	Cute::Array<const char*> image_names;
-	Cute::Array<CF_Pipeline> pip_cache;
+	Cute::Map<uint64_t, CF_CachedPipeline> pip_cache; // Keyed by a hash of render state, vertex layout and target formats.
 
 	CF_INLINE int get_input_index(const char* name)
 	{
@@ -460,8 +485,21 @@ struct CF_ShaderInternal
 	}
 };
 
+// Overrides the number of indices `cf_draw_elements` draws, e.g. to draw only the front portion of a
+// larger static index buffer. Reset by the next call to `cf_mesh_update_index_data`.
+void cf_mesh_set_index_count(CF_Mesh mesh, int count);
+
+// Selects a sub-range of the vertex and instance data previously uploaded to `mesh` for `cf_draw_elements`.
+// The buffers are bound at an offset, so indices stay relative to `first_vertex`. This lets many batches
+// share a single upload. Reset by the next call to `cf_mesh_update_vertex_data` or `cf_mesh_update_instance_data`.
+void cf_mesh_set_draw_range(CF_Mesh mesh, int first_vertex, int vertex_count, int first_instance, int instance_count);
+
 CF_Shader cf_make_draw_shader_internal(const char* path);
 CF_Shader cf_make_draw_shader_from_source_internal(const char* src);
+CF_Shader cf_make_draw_sprite_shader_internal(const char* path);
+CF_Shader cf_make_draw_sprite_shader_from_source_internal(const char* src);
+CF_Shader cf_make_draw_instanced_shader_internal(const char* path);
+CF_Shader cf_make_draw_instanced_shader_from_source_internal(const char* src);
 CF_Shader cf_make_draw_blit_shader_internal(const char* path);
 CF_Shader cf_make_draw_blit_shader_from_source_internal(const char* src);
 void cf_load_internal_shaders();
@@ -0,0 +1,55 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#ifndef CF_SIMD_INTERNAL_H
+#define CF_SIMD_INTERNAL_H
+
+#include <cute_defines.h>
+
+// Picks a SIMD instruction set available at compile time. SSE2 is part of the x64 baseline and
+// NEON is part of the arm64 baseline, so neither needs any runtime detection. Everything else
+// (including 32-bit ARM) falls back to scalar code. Define CF_SIMD_SCALAR to force the scalar
+// paths, which is handy for testing.
+#if !defined(CF_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	define CF_SIMD_SSE2
+#	include <emmintrin.h>
+#elif !defined(CF_SIMD_SCALAR) && (defined(__aarch64__) || defined(_M_ARM64))
+#	define CF_SIMD_NEON
+#	include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+
+// Instruction sets beyond the compile-time baseline (e.g. SSSE3 or AVX2 on x64) may only be used
+// inside functions marked with CF_TARGET, and only after checking the CPU supports them at runtime
+// (e.g. with SDL_HasAVX2). MSVC allows any intrinsic anywhere, so there it expands to nothing.
+#if defined(CF_SIMD_SSE2)
+#	define CF_SIMD_X86
+#	include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#	define CF_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define CF_TARGET(isa)
+#endif
+
+// Index of the lowest set bit. `x` must not be zero.
+CF_INLINE int cf_ctz32(uint32_t x)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, x);
+	return (int)index;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+#endif // CF_SIMD_INTERNAL_H
@@ -29,6 +29,7 @@ TEST_SUITE(test_array);
 TEST_SUITE(test_aseprite);
 TEST_SUITE(test_audio);
 TEST_SUITE(test_base64);
+TEST_SUITE(test_binary);
 TEST_SUITE(test_coroutine);
 TEST_SUITE(test_doubly_list);
 TEST_SUITE(test_hashtable);
@@ -38,6 +39,8 @@ TEST_SUITE(test_sprite);
 TEST_SUITE(test_string);
 TEST_SUITE(test_json);
 TEST_SUITE(test_markups);
+TEST_SUITE(test_triangulate);
+TEST_SUITE(test_draw);
 
 int main(int argc, char* argv[])
 {
@@ -63,6 +66,7 @@ int main(int argc, char* argv[])
 	RUN_TEST_SUITE(test_aseprite);
 	RUN_TEST_SUITE(test_audio);
 	RUN_TEST_SUITE(test_base64);
+	RUN_TEST_SUITE(test_binary);
 	RUN_TEST_SUITE(test_coroutine);
 	RUN_TEST_SUITE(test_doubly_list);
 	RUN_TEST_SUITE(test_hashtable);
@@ -72,6 +76,8 @@ int main(int argc, char* argv[])
 	RUN_TEST_SUITE(test_string);
 	RUN_TEST_SUITE(test_json);
 	RUN_TEST_SUITE(test_markups);
+	RUN_TEST_SUITE(test_triangulate);
+	RUN_TEST_SUITE(test_draw);
 
 	pu_print_stats();
 	return pu_test_failed();
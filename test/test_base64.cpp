@@ -9,6 +9,7 @@
 
 #include <cute_c_runtime.h>
 #include <cute_base64.h>
+#include <cute_alloc.h>
 using namespace Cute;
 
 /* Test vectors from RFC 4648. */
@@ -69,7 +70,53 @@ TEST_CASE(test_base64_encode)
 	return true;
 }
 
+/* Long streams go through the SIMD kernels, make sure they agree with a plain reference encoder. */
+TEST_CASE(test_base64_long_streams)
+{
+	const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	int sizes[] = { 1, 2, 3, 11, 12, 13, 16, 24, 28, 47, 48, 49, 64, 100, 255, 256, 1000, 4099 };
+
+	for (int i = 0; i < CF_ARRAY_SIZE(sizes); ++i) {
+		int size = sizes[i];
+		int encoded_size = (int)CF_BASE64_ENCODED_SIZE(size);
+		uint8_t* src = (uint8_t*)cf_alloc(size);
+		char* expected = (char*)cf_alloc(encoded_size);
+		char* encoded = (char*)cf_alloc(encoded_size);
+		uint8_t* decoded = (uint8_t*)cf_alloc(size);
+		for (int j = 0; j < size; ++j) src[j] = (uint8_t)(j * 131 + size);
+
+		for (int j = 0; j < encoded_size / 4; ++j) {
+			uint32_t bits = 0;
+			for (int k = 0; k < 3; ++k) bits = (bits << 8) | (j * 3 + k < size ? src[j * 3 + k] : 0);
+			for (int k = 0; k < 4; ++k) expected[j * 4 + k] = j * 3 + k <= size ? alphabet[(bits >> (18 - k * 6)) & 0x3F] : '=';
+		}
+
+		// Buffers are sized exactly, so any kernel writing out of bounds gets caught by sanitizers.
+		CHECK(cf_is_error(cf_base64_encode(encoded, encoded_size, src, size)));
+		REQUIRE(!CF_MEMCMP(encoded, expected, encoded_size));
+		CHECK(cf_is_error(cf_base64_decode(decoded, size, encoded, encoded_size)));
+		REQUIRE(!CF_MEMCMP(decoded, src, size));
+
+		// An illegal character anywhere must reject the whole stream.
+		for (int j = 0; j < encoded_size; j += 7) {
+			if (encoded[j] == '=') continue;
+			char c = encoded[j];
+			encoded[j] = j % 2 ? '~' : (char)0xC3;
+			REQUIRE(cf_is_error(cf_base64_decode(decoded, size, encoded, encoded_size)));
+			encoded[j] = c;
+		}
+
+		cf_free(src);
+		cf_free(expected);
+		cf_free(encoded);
+		cf_free(decoded);
+	}
+
+	return true;
+}
+
 TEST_SUITE(test_base64)
 {
 	RUN_TEST_CASE(test_base64_encode);
+	RUN_TEST_CASE(test_base64_long_streams);
 }
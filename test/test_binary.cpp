@@ -0,0 +1,81 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#include "test_harness.h"
+
+#include <cute_c_runtime.h>
+#include <cute_binary.h>
+#include <cute_alloc.h>
+using namespace Cute;
+
+TEST_CASE(test_binary_round_trip)
+{
+	float positions[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+	uint8_t flags[] = { 7, 8, 9 };
+
+	BinaryWriter w = make_binary_writer();
+	uint32_t hero = binary_writer_add_string(w, "hero");
+	REQUIRE(binary_writer_add_string(w, "hero") == hero);
+	REQUIRE(binary_writer_add_string(w, "") == 0);
+	binary_writer_add_section(w, "flags", flags, sizeof(flags));
+	binary_writer_add_section(w, "positions", positions, sizeof(positions));
+	binary_writer_add_section(w, "names", &hero, sizeof(hero));
+	size_t size = 0;
+	void* data = binary_writer_finish(w, &size);
+	destroy_binary_writer(w);
+
+	BinaryReader r;
+	CHECK(cf_is_error(binary_reader_init(&r, data, size)));
+	REQUIRE(binary_section_count(&r) == 3);
+
+	size_t section_size = 0;
+	const float* p = (const float*)binary_section(&r, "positions", &section_size);
+	REQUIRE(p);
+	REQUIRE(section_size == sizeof(positions));
+	REQUIRE(((uintptr_t)p - (uintptr_t)data) % CF_BINARY_ALIGNMENT == 0);
+	REQUIRE(!CF_MEMCMP(p, positions, sizeof(positions)));
+
+	const char* name = NULL;
+	const uint8_t* f = (const uint8_t*)binary_section_at(&r, 0, &name, &section_size);
+	REQUIRE(!CF_STRCMP(name, "flags"));
+	REQUIRE(section_size == sizeof(flags));
+	REQUIRE(!CF_MEMCMP(f, flags, sizeof(flags)));
+
+	const uint32_t* names = (const uint32_t*)binary_section(&r, "names", NULL);
+	REQUIRE(!CF_STRCMP(binary_string(&r, names[0]), "hero"));
+	REQUIRE(binary_section(&r, "missing", NULL) == NULL);
+
+	cf_free(data);
+	return true;
+}
+
+TEST_CASE(test_binary_validation)
+{
+	uint8_t garbage[64] = { 0 };
+	BinaryReader r;
+	REQUIRE(cf_is_error(binary_reader_init(&r, garbage, sizeof(garbage))));
+	REQUIRE(cf_is_error(binary_reader_init(&r, garbage, 4)));
+
+	BinaryWriter w = make_binary_writer();
+	uint32_t x = 10;
+	binary_writer_add_section(w, "x", &x, sizeof(x));
+	size_t size = 0;
+	void* data = binary_writer_finish(w, &size);
+	destroy_binary_writer(w);
+
+	CHECK(cf_is_error(binary_reader_init(&r, data, size)));
+	REQUIRE(cf_is_error(binary_reader_init(&r, data, size - 1)));
+
+	cf_free(data);
+	return true;
+}
+
+TEST_SUITE(test_binary)
+{
+	RUN_TEST_CASE(test_binary_round_trip);
+	RUN_TEST_CASE(test_binary_validation);
+}
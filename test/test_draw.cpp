@@ -0,0 +1,463 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#include "test_harness.h"
+
+#include <cute.h>
+using namespace Cute;
+
+#include <internal/cute_draw_internal.h>
+
+// These run on the null graphics backend, which counts draw calls without a GPU or display.
+static CF_Result s_make_app()
+{
+	return cf_make_app(NULL, 0, 0, 0, 640, 480, APP_OPTIONS_HIDDEN_BIT | APP_OPTIONS_NO_AUDIO_BIT | APP_OPTIONS_GFX_NULL_BIT, NULL);
+}
+
+// Renders everything drawn so far and returns the stats of that frame.
+static CF_DrawStats s_frame()
+{
+	cf_app_draw_onto_screen(false);
+	return cf_draw_get_stats();
+}
+
+// A row of small boxes, all within the 640x480 canvas.
+static void s_draw_boxes(int count)
+{
+	for (int i = 0; i < count; ++i) {
+		cf_draw_box_fill(cf_make_aabb_pos_w_h(cf_v2(-300.0f + i * 10.0f, 0), 8.0f, 8.0f), 0);
+	}
+}
+
+// Alternates between two boxes, one on each half of the canvas, with `push`/`pop` around each of them.
+static void s_draw_alternating(int count, void (*push)(CF_Rect), void (*pop)())
+{
+	CF_Rect halves[2] = { { 0, 0, 320, 480 }, { 320, 0, 320, 480 } };
+	for (int i = 0; i < count; ++i) {
+		push(halves[i & 1]);
+		cf_draw_box_fill(cf_make_aabb_pos_w_h(cf_v2((i & 1) ? 160.0f : -160.0f, 0), 8.0f, 8.0f), 0);
+		pop();
+	}
+}
+
+static void s_push_scissor(CF_Rect scissor) { cf_draw_push_scissor(scissor); }
+static void s_pop_scissor() { cf_draw_pop_scissor(); }
+static void s_push_viewport(CF_Rect viewport) { cf_draw_push_viewport(viewport); }
+static void s_pop_viewport() { cf_draw_pop_viewport(); }
+
+/* Drawing a frame reports its draw calls, batches and vertices. */
+TEST_CASE(test_draw_stats)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	CF_Pixel pixels[4 * 4];
+	for (int i = 0; i < 4 * 4; ++i) pixels[i].val = 0xFFFFFFFF;
+	CF_Sprite sprite = cf_make_easy_sprite_from_pixels(pixels, 4, 4);
+	cf_draw_sprite(&sprite);
+	s_draw_boxes(10);
+	CF_DrawStats stats = s_frame();
+	REQUIRE(stats.draw_call_count > 0);
+	REQUIRE(stats.batch_count > 0);
+	REQUIRE(stats.upload_count > 0);
+	REQUIRE(stats.vertex_bytes > 0);
+	REQUIRE(stats.culled_count == 0);
+
+	// Stats are reset every frame.
+	stats = s_frame();
+	REQUIRE(stats.batch_count == 0);
+	REQUIRE(stats.vertex_bytes == 0);
+
+	cf_easy_sprite_unload(&sprite);
+	cf_destroy_app();
+	return true;
+}
+
+/* Items entirely offscreen are skipped and counted while culling is on. */
+TEST_CASE(test_draw_culling)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	cf_draw_push_culling(true);
+	for (int i = 0; i < 10; ++i) {
+		cf_draw_box_fill(cf_make_aabb_pos_w_h(cf_v2(5000.0f, 5000.0f + i * 10.0f), 8.0f, 8.0f), 0);
+	}
+	CF_DrawStats stats = s_frame();
+	REQUIRE(stats.culled_count == 10);
+	REQUIRE(stats.vertex_bytes == 0);
+
+	s_draw_boxes(10);
+	stats = s_frame();
+	REQUIRE(stats.culled_count == 0);
+	REQUIRE(stats.vertex_bytes > 0);
+	cf_draw_pop_culling();
+
+	// Off by default.
+	cf_draw_box_fill(cf_make_aabb_pos_w_h(cf_v2(5000.0f, 5000.0f), 8.0f, 8.0f), 0);
+	stats = s_frame();
+	REQUIRE(stats.culled_count == 0);
+	REQUIRE(stats.vertex_bytes > 0);
+
+	cf_destroy_app();
+	return true;
+}
+
+/* Submitting a draw list draws the same as issuing its draw calls directly. */
+TEST_CASE(test_draw_list)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	s_draw_boxes(50);
+	CF_DrawStats direct = s_frame();
+
+	CF_DrawList list = cf_make_draw_list();
+	cf_draw_list_begin(list);
+	s_draw_boxes(50);
+	cf_draw_list_end();
+	CF_DrawStats recorded = s_frame();
+	REQUIRE(recorded.vertex_bytes == 0);
+
+	for (int i = 0; i < 2; ++i) {
+		cf_draw_list_submit(list, cf_make_identity());
+		CF_DrawStats submitted = s_frame();
+		REQUIRE(submitted.batch_count == direct.batch_count);
+		REQUIRE(submitted.draw_call_count == direct.draw_call_count);
+		REQUIRE(submitted.vertex_bytes == direct.vertex_bytes);
+	}
+
+	cf_destroy_draw_list(list);
+	cf_destroy_app();
+	return true;
+}
+
+/* Tilemaps draw their onscreen chunks, and skip ones outside the canvas. */
+TEST_CASE(test_draw_tilemap)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	CF_Pixel pixels[16 * 16];
+	for (int i = 0; i < 16 * 16; ++i) pixels[i].val = 0xFFFFFFFF;
+	CF_Sprite sprite = cf_make_easy_sprite_from_pixels(pixels, 16, 16);
+
+	CF_Tilemap map = cf_make_tilemap(CF_TILEMAP_CHUNK_SIZE * 2, CF_TILEMAP_CHUNK_SIZE * 2, 16.0f, 16.0f);
+	cf_tilemap_set_tile_sprite(map, 1, &sprite);
+	for (int y = 0; y < CF_TILEMAP_CHUNK_SIZE * 2; ++y) {
+		for (int x = 0; x < CF_TILEMAP_CHUNK_SIZE * 2; ++x) {
+			cf_tilemap_set(map, x, y, 1);
+		}
+	}
+	REQUIRE(cf_tilemap_get(map, 3, 5) == 1);
+
+	cf_draw_tilemap(map, cf_v2(0, 0));
+	CF_DrawStats stats = s_frame();
+	REQUIRE(stats.batch_count > 0);
+	REQUIRE(stats.vertex_bytes > 0);
+
+	cf_draw_tilemap(map, cf_v2(100000.0f, 100000.0f));
+	stats = s_frame();
+	REQUIRE(stats.vertex_bytes == 0);
+
+	// Emptying the map leaves nothing to draw.
+	for (int y = 0; y < CF_TILEMAP_CHUNK_SIZE * 2; ++y) {
+		for (int x = 0; x < CF_TILEMAP_CHUNK_SIZE * 2; ++x) {
+			cf_tilemap_set(map, x, y, 0);
+		}
+	}
+	cf_draw_tilemap(map, cf_v2(0, 0));
+	stats = s_frame();
+	REQUIRE(stats.vertex_bytes == 0);
+
+	cf_destroy_tilemap(map);
+	cf_easy_sprite_unload(&sprite);
+	cf_destroy_app();
+	return true;
+}
+
+/* The array entry points draw the same as drawing each item on its own. */
+TEST_CASE(test_draw_arrays)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	CF_Pixel pixels[4 * 4];
+	for (int i = 0; i < 4 * 4; ++i) pixels[i].val = 0xFFFFFFFF;
+	CF_Sprite sprite = cf_make_easy_sprite_from_pixels(pixels, 4, 4);
+	CF_Sprite sprites[100];
+	CF_V2 centers[100];
+	float radii[100];
+	for (int i = 0; i < 100; ++i) {
+		sprites[i] = sprite;
+		sprites[i].transform.p = cf_v2(-300.0f + (i % 10) * 60.0f, -200.0f + (i / 10) * 40.0f);
+		sprites[i].transform.r = cf_sincos_f(i * 0.1f);
+		centers[i] = sprites[i].transform.p;
+		radii[i] = 2.0f + (i % 5);
+	}
+
+	for (int i = 0; i < 100; ++i) {
+		cf_draw_sprite(sprites + i);
+	}
+	CF_DrawStats one_by_one = s_frame();
+
+	cf_draw_sprites(sprites, 100);
+	CF_DrawStats bulk = s_frame();
+	REQUIRE(one_by_one.sprite_count == 100);
+	REQUIRE(bulk.sprite_count == one_by_one.sprite_count);
+	REQUIRE(bulk.batch_count == one_by_one.batch_count);
+	REQUIRE(bulk.draw_call_count == one_by_one.draw_call_count);
+	REQUIRE(bulk.vertex_bytes == one_by_one.vertex_bytes);
+
+	for (int i = 0; i < 100; ++i) {
+		cf_draw_circle_fill2(centers[i], radii[i]);
+	}
+	one_by_one = s_frame();
+
+	cf_draw_circles_fill(centers, radii, 100);
+	bulk = s_frame();
+	REQUIRE(bulk.batch_count == one_by_one.batch_count);
+	REQUIRE(bulk.draw_call_count == one_by_one.draw_call_count);
+	REQUIRE(bulk.vertex_bytes == one_by_one.vertex_bytes);
+
+	cf_easy_sprite_unload(&sprite);
+	cf_destroy_app();
+	return true;
+}
+
+/* Filling vertices across threads gives exactly the same vertices as filling them on one. */
+TEST_CASE(test_draw_parallel_fill)
+{
+	CHECK(cf_is_error(s_make_app()));
+	CHECK(cf_is_error(cf_fs_set_write_directory(cf_fs_get_base_directory())));
+
+	CF_Pixel pixels[4 * 4];
+	for (int i = 0; i < 4 * 4; ++i) pixels[i].val = 0xFFFFFFFF;
+	CF_Sprite sprite = cf_make_easy_sprite_from_pixels(pixels, 4, 4);
+
+	// Batches well past the size split up across threads, with both the instanced and regular vertex paths.
+	const char* paths[2] = { "/draw_serial.capture", "/draw_parallel.capture" };
+	int thresholds[2] = { 0, 1 };
+	CF_DrawStats stats[2];
+	for (int i = 0; i < 2; ++i) {
+		cf_draw_set_parallel_threshold(thresholds[i]);
+		REQUIRE(cf_draw_get_parallel_threshold() == thresholds[i]);
+		cf_draw_capture_begin();
+		for (int j = 0; j < 2; ++j) {
+			cf_draw_set_instancing(j == 0);
+			for (int k = 0; k < 5000; ++k) {
+				CF_V2 p = cf_v2(-320.0f + (k % 80) * 8.0f, -240.0f + (k / 80) * 7.0f);
+				sprite.transform.p = p;
+				cf_draw_sprite(&sprite);
+				cf_draw_circle_fill2(p, 3.0f);
+			}
+			cf_render_to(cf_app_get_canvas(), false);
+		}
+		stats[i] = s_frame();
+		CHECK(cf_is_error(cf_draw_capture_end(paths[i])));
+	}
+	cf_draw_set_instancing(true);
+	REQUIRE(stats[0].batch_count == stats[1].batch_count);
+	REQUIRE(stats[0].draw_call_count == stats[1].draw_call_count);
+	REQUIRE(stats[0].sprite_count == stats[1].sprite_count);
+	REQUIRE(stats[0].vertex_bytes == stats[1].vertex_bytes);
+
+	CF_BinaryReader readers[2];
+	const void* vertices[2];
+	size_t sizes[2];
+	void* files[2];
+	for (int i = 0; i < 2; ++i) {
+		size_t file_size = 0;
+		files[i] = cf_fs_read_entire_file_to_memory(paths[i], &file_size);
+		REQUIRE(files[i]);
+		CHECK(cf_is_error(cf_binary_reader_init(readers + i, files[i], file_size)));
+		vertices[i] = cf_binary_section(readers + i, "draw.vertices", sizes + i);
+		REQUIRE(vertices[i]);
+	}
+	REQUIRE(sizes[0] > 0);
+	REQUIRE(sizes[0] == sizes[1]);
+	REQUIRE(!CF_MEMCMP(vertices[0], vertices[1], sizes[0]));
+
+	for (int i = 0; i < 2; ++i) {
+		cf_free(files[i]);
+		cf_fs_remove(paths[i]);
+	}
+	cf_easy_sprite_unload(&sprite);
+	cf_destroy_app();
+	return true;
+}
+
+/* Reordering merges non-overlapping items split up by scissors, but never moves them across a viewport change. */
+TEST_CASE(test_draw_reordering)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	s_draw_alternating(20, s_push_scissor, s_pop_scissor);
+	CF_DrawStats in_order = s_frame();
+	REQUIRE(in_order.batches_saved == 0);
+
+	cf_draw_set_batch_reordering(true);
+	REQUIRE(cf_draw_get_batch_reordering());
+	s_draw_alternating(20, s_push_scissor, s_pop_scissor);
+	CF_DrawStats reordered = s_frame();
+	REQUIRE(reordered.batches_saved > 0);
+	REQUIRE(reordered.batch_count < in_order.batch_count);
+	REQUIRE(reordered.vertex_bytes == in_order.vertex_bytes);
+
+	s_draw_alternating(20, s_push_viewport, s_pop_viewport);
+	CF_DrawStats viewports = s_frame();
+	REQUIRE(viewports.batches_saved == 0);
+
+	cf_draw_set_batch_reordering(false);
+	cf_destroy_app();
+	return true;
+}
+
+/* Per-vertex scissors let differently clipped items share a batch. */
+TEST_CASE(test_draw_vertex_scissor)
+{
+	CHECK(cf_is_error(s_make_app()));
+
+	s_draw_alternating(20, s_push_scissor, s_pop_scissor);
+	CF_DrawStats hardware = s_frame();
+
+	cf_draw_set_vertex_scissor(true);
+	REQUIRE(cf_draw_get_vertex_scissor());
+	s_draw_alternating(20, s_push_scissor, s_pop_scissor);
+	CF_DrawStats vertex = s_frame();
+	REQUIRE(vertex.batch_count < hardware.batch_count);
+	REQUIRE(vertex.draw_call_count < hardware.draw_call_count);
+	REQUIRE(vertex.vertex_bytes == hardware.vertex_bytes);
+
+	cf_draw_set_vertex_scissor(false);
+	cf_destroy_app();
+	return true;
+}
+
+/* Canvases keep their painter's order against sprites, while repeated draws of one canvas share a batch. */
+TEST_CASE(test_draw_canvas)
+{
+	CHECK(cf_is_error(s_make_app()));
+	CHECK(cf_is_error(cf_fs_set_write_directory(cf_fs_get_base_directory())));
+
+	CF_Pixel pixels[4 * 4];
+	for (int i = 0; i < 4 * 4; ++i) pixels[i].val = 0xFFFFFFFF;
+	CF_Sprite sprite = cf_make_easy_sprite_from_pixels(pixels, 4, 4);
+	CF_Canvas canvas = cf_make_canvas(cf_canvas_defaults(64, 64));
+	uint64_t canvas_texture = cf_canvas_get_target(canvas).id;
+
+	// Sprite, canvas, sprite, all in the same layer. Sorting by texture would draw both sprites first.
+	cf_draw_capture_begin();
+	sprite.transform.p = cf_v2(-100.0f, 0);
+	cf_draw_sprite(&sprite);
+	cf_draw_canvas(canvas, cf_v2(0, 0), cf_v2(64.0f, 64.0f));
+	sprite.transform.p = cf_v2(100.0f, 0);
+	cf_draw_sprite(&sprite);
+	CF_DrawStats stats = s_frame();
+	CHECK(cf_is_error(cf_draw_capture_end("/draw_canvas.capture")));
+	REQUIRE(stats.batch_count == 3);
+
+	size_t file_size = 0;
+	void* file = cf_fs_read_entire_file_to_memory("/draw_canvas.capture", &file_size);
+	REQUIRE(file);
+	CF_BinaryReader reader;
+	CHECK(cf_is_error(cf_binary_reader_init(&reader, file, file_size)));
+	size_t size = 0;
+	const CF_DrawCaptureBatch* batches = (const CF_DrawCaptureBatch*)cf_binary_section(&reader, "draw.batches", &size);
+	REQUIRE(batches && size == 3 * sizeof(CF_DrawCaptureBatch));
+	REQUIRE(batches[0].texture_id != canvas_texture);
+	REQUIRE(batches[1].texture_id == canvas_texture);
+	REQUIRE(batches[2].texture_id != canvas_texture);
+	cf_free(file);
+	cf_fs_remove("/draw_canvas.capture");
+
+	// Drawing the canvas again right after costs nothing extra.
+	cf_draw_canvas(canvas, cf_v2(0, 0), cf_v2(64.0f, 64.0f));
+	CF_DrawStats once = s_frame();
+	for (int i = 0; i < 5; ++i) {
+		cf_draw_canvas(canvas, cf_v2(i * 70.0f - 140.0f, 0), cf_v2(64.0f, 64.0f));
+	}
+	CF_DrawStats repeated = s_frame();
+	REQUIRE(once.batch_count == 1);
+	REQUIRE(repeated.batch_count == once.batch_count);
+	REQUIRE(repeated.draw_call_count == once.draw_call_count);
+
+	cf_destroy_canvas(canvas);
+	cf_easy_sprite_unload(&sprite);
+	cf_destroy_app();
+	return true;
+}
+
+/* Replaying a captured frame draws the same as the frame itself. */
+TEST_CASE(test_draw_capture_replay)
+{
+	CHECK(cf_is_error(s_make_app()));
+	CHECK(cf_is_error(cf_fs_set_write_directory(cf_fs_get_base_directory())));
+
+	CF_Pixel pixels[4 * 4];
+	for (int i = 0; i < 4 * 4; ++i) pixels[i].val = 0xFF00FFFF;
+	CF_Sprite sprite = cf_make_easy_sprite_from_pixels(pixels, 4, 4);
+
+	cf_draw_capture_begin();
+	s_draw_boxes(10);
+	cf_draw_push_scissor({ 0, 0, 320, 240 });
+	cf_draw_sprite(&sprite);
+	cf_draw_pop_scissor();
+	cf_draw_circle_fill2(cf_v2(100.0f, 100.0f), 20.0f);
+	CF_DrawStats captured = s_frame();
+	CHECK(cf_is_error(cf_draw_capture_end("/draw_test.capture")));
+
+	for (int i = 0; i < 2; ++i) {
+		CHECK(cf_is_error(cf_draw_replay_capture("/draw_test.capture", cf_app_get_canvas())));
+		CF_DrawStats replayed = s_frame();
+		REQUIRE(replayed.draw_call_count == captured.draw_call_count);
+		REQUIRE(replayed.batch_count == captured.batch_count);
+		REQUIRE(replayed.upload_count == captured.upload_count);
+		REQUIRE(replayed.vertex_bytes == captured.vertex_bytes);
+	}
+
+	REQUIRE(cf_is_error(cf_draw_replay_capture("/missing.capture", cf_app_get_canvas())));
+
+	// Corrupt batches are rejected before anything is drawn.
+	size_t file_size = 0;
+	void* file = cf_fs_read_entire_file_to_memory("/draw_test.capture", &file_size);
+	REQUIRE(file);
+	CF_BinaryReader reader;
+	CHECK(cf_is_error(cf_binary_reader_init(&reader, file, file_size)));
+	size_t size = 0;
+	CF_DrawCaptureBatch* batches = (CF_DrawCaptureBatch*)cf_binary_section(&reader, "draw.batches", &size);
+	REQUIRE(batches && size >= sizeof(CF_DrawCaptureBatch));
+	for (int i = 0; i < 4; ++i) {
+		CF_DrawCaptureBatch original = *batches;
+		switch (i) {
+		case 0: batches->index_count = batches->vertex_count / 4 * 6 + 6; break;
+		case 1: batches->index_count = -6; break;
+		case 2: batches->texture_w = 1 << 20; break;
+		case 3: batches->mesh = CF_DRAW_CAPTURE_MESH_COUNT; break;
+		}
+		CHECK(cf_is_error(cf_fs_write_entire_buffer_to_file("/draw_corrupt.capture", file, file_size)));
+		REQUIRE(cf_is_error(cf_draw_replay_capture("/draw_corrupt.capture", cf_app_get_canvas())));
+		*batches = original;
+	}
+	s_frame();
+	cf_free(file);
+	cf_fs_remove("/draw_corrupt.capture");
+
+	cf_fs_remove("/draw_test.capture");
+	cf_easy_sprite_unload(&sprite);
+	cf_destroy_app();
+	return true;
+}
+
+TEST_SUITE(test_draw)
+{
+	RUN_TEST_CASE(test_draw_stats);
+	RUN_TEST_CASE(test_draw_culling);
+	RUN_TEST_CASE(test_draw_list);
+	RUN_TEST_CASE(test_draw_tilemap);
+	RUN_TEST_CASE(test_draw_arrays);
+	RUN_TEST_CASE(test_draw_parallel_fill);
+	RUN_TEST_CASE(test_draw_reordering);
+	RUN_TEST_CASE(test_draw_vertex_scissor);
+	RUN_TEST_CASE(test_draw_canvas);
+	RUN_TEST_CASE(test_draw_capture_replay);
+}
@@ -262,6 +262,143 @@ TEST_CASE(test_split_for_memleaks)
 	return true;
 }
 
+/* Bulk UTF8 decoding must match decoding one codepoint at a time. */
+TEST_CASE(test_decode_UTF8_bulk)
+{
+	const char* text = "The quick brown fox jumps over the lazy dog. \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E \xC3\xA9t\xC3\xA9 \xF0\x9F\x98\x80 plus a long ASCII tail to exercise the fast path.";
+	int len = (int)CF_STRLEN(text);
+	Array<int> bulk;
+	bulk.ensure_count(len);
+	int count = cf_decode_UTF8_bulk(text, len, bulk.data());
+
+	int i = 0;
+	const char* tmp = text;
+	while (*tmp) {
+		int cp;
+		tmp = cf_decode_UTF8(tmp, &cp);
+		REQUIRE(i < count);
+		REQUIRE(bulk[i++] == cp);
+	}
+	REQUIRE(i == count);
+
+	// Invalid and truncated sequences.
+	const char* bad = "abc\x80\xE6\x97";
+	count = cf_decode_UTF8_bulk(bad, 6, bulk.data());
+	REQUIRE(count == 5);
+	REQUIRE(bulk[2] == 'c');
+	REQUIRE(bulk[3] == 0xFFFD);
+	REQUIRE(bulk[4] == 0xFFFD);
+
+	return true;
+}
+
+/* Transcode UTF16 to UTF8. */
+TEST_CASE(test_append_UTF16)
+{
+	const uint16_t text[] = { 'H', 'e', 'l', 'l', 'o', ',', ' ', 'w', 'o', 'r', 'l', 'd', ' ', 0x65E5, 0x672C, ' ', 0xD83D, 0xDE00, ' ', 0xD800, '!', 0 };
+	char* s = NULL;
+	sappend_UTF16(s, text, -1);
+	REQUIRE(!CF_STRCMP(s, "Hello, world \xE6\x97\xA5\xE6\x9C\xAC \xF0\x9F\x98\x80 \xEF\xBF\xBD!"));
+	REQUIRE(slen(s) == (int)CF_STRLEN(s));
+	sappend_UTF16(s, text, 5);
+	REQUIRE(ssuffix(s, "!Hello"));
+	sfree(s);
+
+	return true;
+}
+
+/* Number formatting and parsing without format strings. */
+TEST_CASE(test_append_and_parse_numbers)
+{
+	char* s = NULL;
+	sappend_int(s, -1234567890123LL);
+	spush(s, ' ');
+	sappend_uint(s, 18446744073709551615ULL);
+	spush(s, ' ');
+	sappend_float(s, 0.1f);
+	spush(s, ' ');
+	sappend_float(s, 1.0f);
+	spush(s, ' ');
+	sappend_double(s, 2.5e-300);
+	REQUIRE(!CF_STRCMP(s, "-1234567890123 18446744073709551615 0.1 1 2.5e-300"));
+	REQUIRE(slen(s) == (int)CF_STRLEN(s));
+	sfree(s);
+
+	// Shortest text must round-trip exactly.
+	float values[] = { 3.14159265f, 1.0e-7f, 123456.789f, -0.0f, 3.4028235e38f, 1.17549435e-38f };
+	for (int i = 0; i < (int)CF_ARRAY_SIZE(values); ++i) {
+		char* t = NULL;
+		sappend_float(t, values[i]);
+		float parsed = 0;
+		const char* end = cf_sparse_float(t, NULL, &parsed);
+		REQUIRE(end == t + slen(t));
+		REQUIRE(!CF_MEMCMP(&parsed, values + i, sizeof(float)));
+		sfree(t);
+	}
+
+	const char* text = "+42,-7,x";
+	int64_t i = 0;
+	text = cf_sparse_int(text, NULL, &i);
+	REQUIRE(text && *text == ',' && i == 42);
+	text = cf_sparse_int(text + 1, NULL, &i);
+	REQUIRE(text && *text == ',' && i == -7);
+	REQUIRE(cf_sparse_int(text + 1, NULL, &i) == NULL);
+	REQUIRE(cf_sparse_int("99999999999999999999", NULL, &i) == NULL);
+
+	double d = 0;
+	const char* range = "1.5e3 is not the end";
+	REQUIRE(cf_sparse_double(range, range + 3, &d) == range + 3);
+	REQUIRE(d == 1.5);
+	REQUIRE(cf_sparse_double(range, NULL, &d) == range + 5);
+	REQUIRE(d == 1500.0);
+
+	return true;
+}
+
+/* Build strings spanning many chunks. */
+TEST_CASE(test_string_builder)
+{
+	CF_StringBuilder sb;
+	cf_string_builder_init(&sb, 16);
+	char* expected = NULL;
+	sset(expected, "");
+	for (int i = 0; i < 100; ++i) {
+		cf_string_builder_append(&sb, "abc");
+		cf_string_builder_append_int(&sb, i);
+		cf_string_builder_fmt(&sb, "[%s]", i % 10 ? "x" : "a much longer piece of text than one chunk");
+		expected = cf_sfmt_append(expected, "abc%d[%s]", i, i % 10 ? "x" : "a much longer piece of text than one chunk");
+	}
+	REQUIRE(cf_string_builder_len(&sb) == slen(expected));
+
+	char* s = cf_string_builder_to_string(&sb);
+	REQUIRE(!CF_STRCMP(s, expected));
+	REQUIRE(slen(s) == slen(expected));
+	sfree(s);
+
+	int count = 0;
+	int total = 0;
+	const CF_StringChunk* chunks = cf_string_builder_chunks(&sb, &count);
+	for (int i = 0; i < count; ++i) {
+		REQUIRE(!CF_MEMCMP(chunks[i].data, expected + total, chunks[i].len));
+		total += chunks[i].len;
+	}
+	REQUIRE(total == slen(expected));
+
+	// Memory is reused after clearing.
+	cf_string_builder_clear(&sb);
+	REQUIRE(cf_string_builder_len(&sb) == 0);
+	cf_string_builder_append_float(&sb, 0.5f);
+	s = cf_string_builder_to_string(&sb);
+	REQUIRE(!CF_STRCMP(s, "0.5"));
+	sfree(s);
+	REQUIRE(cf_string_builder_chunks(&sb, &count)->data == chunks[0].data);
+
+	sfree(expected);
+	cf_string_builder_destroy(&sb);
+
+	return true;
+}
+
 TEST_SUITE(test_string)
 {
 	RUN_TEST_CASE(test_array_macros_simple);
@@ -270,4 +407,8 @@ TEST_SUITE(test_string)
 	RUN_TEST_CASE(test_string_interning);
 	RUN_TEST_CASE(test_dictionary_and_interning);
 	RUN_TEST_CASE(test_split_for_memleaks);
+	RUN_TEST_CASE(test_decode_UTF8_bulk);
+	RUN_TEST_CASE(test_append_UTF16);
+	RUN_TEST_CASE(test_append_and_parse_numbers);
+	RUN_TEST_CASE(test_string_builder);
 }
@@ -0,0 +1,150 @@
+/*
+	Cute Framework
+	Copyright (C) 2024 Randy Gaul https://randygaul.github.io/
+
+	This software is dual-licensed with zlib or Unlicense, check LICENSE.txt for more info
+*/
+
+#include "test_harness.h"
+
+#include <cute.h>
+using namespace Cute;
+
+#include <internal/cute_draw_internal.h>
+
+static float s_polygon_area(const v2* points, int count)
+{
+	float area = 0;
+	for (int i = 0, j = count - 1; i < count; j = i++) {
+		area += points[j].x * points[i].y - points[i].x * points[j].y;
+	}
+	return CF_FABSF(area) * 0.5f;
+}
+
+// Triangulates the polygon and checks every triangle is CCW, and that together they cover the polygon's area.
+static bool s_check_triangulation(const v2* points, int count, int triangle_count = -1)
+{
+	CF_Triangulator t;
+	REQUIRE(cf_triangulate(&t, points, count));
+	REQUIRE(t.indices.count() % 3 == 0);
+	if (triangle_count >= 0) REQUIRE(t.indices.count() / 3 == triangle_count);
+	float area = 0;
+	for (int i = 0; i < t.indices.count(); i += 3) {
+		REQUIRE(t.indices[i] >= 0 && t.indices[i] < count);
+		REQUIRE(t.indices[i + 1] >= 0 && t.indices[i + 1] < count);
+		REQUIRE(t.indices[i + 2] >= 0 && t.indices[i + 2] < count);
+		v2 a = points[t.indices[i]];
+		v2 b = points[t.indices[i + 1]];
+		v2 c = points[t.indices[i + 2]];
+		float twice_area = cross(b - a, c - a);
+		REQUIRE(twice_area > 0);
+		area += twice_area * 0.5f;
+	}
+	float expected = s_polygon_area(points, count);
+	REQUIRE(CF_FABSF(area - expected) <= 1.0e-4f * cf_max(1.0f, expected));
+	return true;
+}
+
+/* CW and CCW input both give CCW triangles. */
+TEST_CASE(test_triangulate_winding)
+{
+	v2 ccw[] = { V2(0, 0), V2(4, 0), V2(4, 3), V2(2, 5), V2(0, 3) };
+	v2 cw[] = { V2(0, 3), V2(2, 5), V2(4, 3), V2(4, 0), V2(0, 0) };
+	REQUIRE(s_check_triangulation(ccw, CF_ARRAY_SIZE(ccw), 3));
+	REQUIRE(s_check_triangulation(cw, CF_ARRAY_SIZE(cw), 3));
+	return true;
+}
+
+/* Repeated vertices, including the last one repeating the first, are skipped. */
+TEST_CASE(test_triangulate_duplicates)
+{
+	v2 points[] = { V2(0, 0), V2(0, 0), V2(2, 0), V2(2, 0), V2(2, 2), V2(0, 2), V2(0, 0) };
+	REQUIRE(s_check_triangulation(points, CF_ARRAY_SIZE(points), 2));
+
+	v2 degenerate[] = { V2(1, 1), V2(1, 1), V2(1, 1) };
+	CF_Triangulator t;
+	REQUIRE(cf_triangulate(&t, degenerate, CF_ARRAY_SIZE(degenerate)));
+	REQUIRE(t.indices.count() == 0);
+	return true;
+}
+
+/* Runs of collinear vertices are skipped, also where the polygon wraps around. */
+TEST_CASE(test_triangulate_collinear)
+{
+	v2 points[] = { V2(0, 0), V2(1, 0), V2(2, 0), V2(3, 0), V2(3, 1), V2(3, 2), V2(0, 2), V2(0, 1) };
+	REQUIRE(s_check_triangulation(points, CF_ARRAY_SIZE(points), 2));
+
+	v2 wrapped[] = { V2(1, 0), V2(2, 0), V2(3, 0), V2(3, 2), V2(0, 2), V2(0, 0) };
+	REQUIRE(s_check_triangulation(wrapped, CF_ARRAY_SIZE(wrapped), 2));
+
+	v2 line[] = { V2(0, 0), V2(1, 1), V2(2, 2), V2(3, 3) };
+	CF_Triangulator t;
+	REQUIRE(cf_triangulate(&t, line, CF_ARRAY_SIZE(line)));
+	REQUIRE(t.indices.count() == 0);
+	return true;
+}
+
+/* Notches from the top and bottom create merge and split vertices, which need diagonals. */
+TEST_CASE(test_triangulate_split_merge)
+{
+	v2 points[] = {
+		V2(0, 0), V2(1, 0), V2(2, 2), V2(3, 0), V2(4, 0),
+		V2(4, 4), V2(3, 4), V2(2, 2.5f), V2(1, 4), V2(0, 4),
+	};
+	REQUIRE(s_check_triangulation(points, CF_ARRAY_SIZE(points), 8));
+
+	// A comb, with many edges crossing the sweep line at once. Flipped, every tooth becomes a merge vertex.
+	Array<v2> comb;
+	for (int i = 0; i < 200; ++i) {
+		comb.add(V2((float)(2 * i), 0));
+		comb.add(V2((float)(2 * i + 1), 10));
+		comb.add(V2((float)(2 * i + 1), 1));
+	}
+	comb.add(V2(400, 0));
+	comb.add(V2(400, -1));
+	comb.add(V2(0, -1));
+	REQUIRE(s_check_triangulation(comb.data(), comb.count(), comb.count() - 2));
+	for (int i = 0; i < comb.count(); ++i) {
+		comb[i].y = -comb[i].y;
+	}
+	REQUIRE(s_check_triangulation(comb.data(), comb.count(), comb.count() - 2));
+	return true;
+}
+
+/* Star-shaped polygons with random radii, a mix of every vertex type. */
+TEST_CASE(test_triangulate_area)
+{
+	CF_RndState rnd = cf_rnd_seed(7);
+	Array<v2> points;
+	for (int k = 0; k < 50; ++k) {
+		int count = cf_rnd_range_int(&rnd, 3, 100);
+		points.clear();
+		for (int i = 0; i < count; ++i) {
+			float angle = 2.0f * CF_PI * i / count;
+			float radius = cf_rnd_range_float(&rnd, 1.0f, 10.0f);
+			points.add(V2(radius * CF_COSF(angle), radius * CF_SINF(angle)));
+		}
+		if (k & 1) points.reverse();
+		REQUIRE(s_check_triangulation(points.data(), points.count(), count - 2));
+	}
+	return true;
+}
+
+/* Self-intersecting polygons are rejected rather than triangulated. */
+TEST_CASE(test_triangulate_not_simple)
+{
+	v2 bowtie[] = { V2(0, 0), V2(2, 2), V2(2, 0), V2(0, 2) };
+	CF_Triangulator t;
+	REQUIRE(!cf_triangulate(&t, bowtie, CF_ARRAY_SIZE(bowtie)));
+	return true;
+}
+
+TEST_SUITE(test_triangulate)
+{
+	RUN_TEST_CASE(test_triangulate_winding);
+	RUN_TEST_CASE(test_triangulate_duplicates);
+	RUN_TEST_CASE(test_triangulate_collinear);
+	RUN_TEST_CASE(test_triangulate_split_merge);
+	RUN_TEST_CASE(test_triangulate_area);
+	RUN_TEST_CASE(test_triangulate_not_simple);
+}